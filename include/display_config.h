@@ -38,14 +38,66 @@
 #define TOUCH_I2C_ADDR  0x38
 #define TOUCH_SDA       G11
 #define TOUCH_SCL       G12
+#define TOUCH_I2C_FREQ  400000  // Fast mode - one burst read of a touch point takes ~0.25 ms
+#define TOUCH_STATS_PERIOD 5000 // Touch bus usage / latency log period (TOUCH_VERBOSE)
+
+// Encoder Configuration
+#define ENCODER_FILTER          1023    // PCNT glitch filter [APB cycles, max 1023 = 12.8 us]
+#define ENCODER_GLITCH_US       2000    // Reversals faster than this are contact bounce
+#define ENCODER_ACCEL_TIMEOUT   200000  // Pause that resets the velocity [us]
+#define ENCODER_ACCEL_MIN_SPEED 10      // No acceleration below [detents/s]
+#define ENCODER_ACCEL_MAX_SPEED 60      // Full acceleration above [detents/s]
+#define ENCODER_ACCEL_MAX       8       // Maximum step multiplier
+#define ENCODER_EVENT_QUEUE     32      // Detents buffered between two polls
+
+// Battery Configuration (MAX17048 fuel gauge)
+#define BATTERY_SAMPLE_PERIOD   60000   // Regular fuel gauge read [ms]
+#define BATTERY_FILTER_SHIFT    2       // EMA weight of a new sample = 1 / 2^shift
+#define BATTERY_BUCKET_SIZE     20      // Displayed steps [%]
+#define BATTERY_HYSTERESIS      3       // Margin before leaving a bucket [%]
+#define BATTERY_ALERT_VMIN      3.3f    // Low voltage alert [V]
+#define BATTERY_ALERT_VMAX      4.35f   // High voltage alert [V]
 
 // LVGL Configuration
-#define DRAW_BUF_SIZE   (LCD_WIDTH * LCD_HEIGHT * 2)  // *2 for switching between buffers
-#define BUF_DIVIDER     4 // BUFFER DIVIDER for lvgl, partial rendering
-// BUFFER = DRAW_BUF_SIZE / BUF_DIVIDER
+#define RENDER_MODE_PARTIAL 0   // Render in stripes of DISPLAY_BUF_LINES into small buffers
+#define RENDER_MODE_DIRECT  1   // Render into full frame buffers, flush only dirty areas
+
+#define DISPLAY_RENDER_MODE RENDER_MODE_PARTIAL
+#define DISPLAY_BUF_COUNT   1   // 1 = single buffer, 2 = render while the other buffer is flushed
+#define DISPLAY_BUF_LINES   60  // Stripe height in partial mode
+#define DISPLAY_BUF_CAPS    (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA) // Buffer memory placement (heap_caps)
+
+#if DISPLAY_RENDER_MODE == RENDER_MODE_DIRECT
+    #define DRAW_BUF_SIZE   (LCD_WIDTH * LCD_HEIGHT * 2)
+#else
+    #define DRAW_BUF_SIZE   (LCD_WIDTH * DISPLAY_BUF_LINES * 2)
+#endif
+// RAM cost = DRAW_BUF_SIZE * DISPLAY_BUF_COUNT
+
+// Software draw units (LV_DRAW_SW_DRAW_UNIT_CNT) - one FreeRTOS task each (src/lvgl/os/lv_os_esp32.cpp)
+#define DRAW_THREAD_CORE        1   // The display task runs on core 0
+#define DRAW_THREAD_PRIORITY    3   // Same as the display task, above the WiFi task
+
+// lv_display_set_buffers() takes at most two buffers - more would be allocated and never used
+static_assert(DISPLAY_BUF_COUNT >= 1 && DISPLAY_BUF_COUNT <= 2, "DISPLAY_BUF_COUNT must be 1 or 2");
 
 #define TFT_ROTATION    LV_DISPLAY_ROTATION_0
 #define DISPLAY_FPS     200      // Display task tick rate
 #define SPLASH_SCREEN_TIME 1000 // Splash screen time
+#define DISPLAY_STATS_PERIOD 5000 // Frame time log period (DISPLAY_VERBOSE)
+
+// Idle mode - dim, then turn the backlight off and pause rendering
+#define IDLE_DIM_TIMEOUT        30000   // Inactivity before dimming [ms]
+#define IDLE_OFF_TIMEOUT        120000  // Inactivity before screen off [ms]
+#define BRIGHTNESS_ACTIVE       255
+#define BRIGHTNESS_DIMMED       40
+#define DISPLAY_FPS_DIMMED      20      // Display task tick rate while dimmed
+#define IDLE_WAKE_POLL_PERIOD   50      // Encoder / button polling while off [ms] - a touch ends the wait on its interrupt
+#define IDLE_POLL_DIMMED        1000    // Volumio state poll of the selected player while dimmed [ms]
+#define IDLE_POLL_OFF           5000    // Volumio state poll of the selected player while off [ms]
+
+// Render benchmark - run a scripted scenario after boot and log the results
+#define DISPLAY_BENCHMARK       false
+#define BENCHMARK_PHASE_TIME    5000    // Duration of each scenario phase
 
 #endif // DISPLAY_CONFIG_H
\ No newline at end of file
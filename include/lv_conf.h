@@ -78,10 +78,27 @@
  * - LV_OS_RTTHREAD
  * - LV_OS_WINDOWS
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+#if defined(ESP_PLATFORM)
+    /*FreeRTOS primitives with the draw threads pinned to DRAW_THREAD_CORE at DRAW_THREAD_PRIORITY
+     *(display_config.h) - LVGL's own FreeRTOS port creates them without core affinity*/
+    #define LV_USE_OS   LV_OS_CUSTOM
+#elif defined(HOST_DRAW_UNITS) && HOST_DRAW_UNITS > 1
+    /*Host build with parallel draw units (native_ui_2units) - 1 vs. 2 units in ui_bench*/
+    #define LV_USE_OS   LV_OS_PTHREAD
+#else
+    /*Host build (native environment) - single threaded*/
+    #define LV_USE_OS   LV_OS_NONE
+#endif
+
+#if LV_USE_OS != LV_OS_NONE
+    /*Stack size and priority of the draw threads (one per software draw unit).
+     *The ESP32 layer uses DRAW_THREAD_PRIORITY instead of the priority*/
+    #define LV_DRAW_THREAD_STACK_SIZE   (8 * 1024)   /*[bytes]*/
+    #define LV_DRAW_THREAD_PRIO         LV_THREAD_PRIO_HIGH
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
-    #define LV_OS_CUSTOM_INCLUDE <stdint.h>
+    #define LV_OS_CUSTOM_INCLUDE "lv_os_esp32.h"
 #endif
 
 /*========================
@@ -99,7 +116,13 @@
     /* Set the number of draw unit.
      * > 1 requires an operating system enabled in `LV_USE_OS`
      * > 1 means multiply threads will render the screen in parallel */
-    #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #if defined(HOST_DRAW_UNITS)
+        #define LV_DRAW_SW_DRAW_UNIT_CNT    HOST_DRAW_UNITS
+    #elif LV_USE_OS != LV_OS_NONE
+        #define LV_DRAW_SW_DRAW_UNIT_CNT    2
+    #else
+        #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #endif
 
     /* Use Arm-2D to accelerate the sw render */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -720,7 +743,7 @@
  *==================*/
 
 /*1: Enable API to take snapshot for object*/
-#define LV_USE_SNAPSHOT 0
+#define LV_USE_SNAPSHOT 1
 
 /*1: Enable system monitor component*/
 #define LV_USE_SYSMON   0
@@ -0,0 +1,31 @@
+/**
+ * @file lv_os_esp32.h
+ * LVGL OS layer on ESP-IDF FreeRTOS with the draw threads pinned to a core
+ *
+ * Same primitives as LVGL's FreeRTOS port, but the draw threads are created
+ * with xTaskCreatePinnedToCore() on DRAW_THREAD_CORE at DRAW_THREAD_PRIORITY
+ * (display_config.h). Included by LVGL through LV_OS_CUSTOM_INCLUDE, so it
+ * stays plain C. Implemented in src/lvgl/os/lv_os_esp32.cpp.
+ */
+#ifndef LV_OS_ESP32_H
+#define LV_OS_ESP32_H
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+typedef struct {
+    TaskHandle_t task;
+    void (*callback)(void *);
+    void * user_data;
+} lv_thread_t;
+
+typedef struct {
+    SemaphoreHandle_t mutex;    /*Recursive, like the FreeRTOS port*/
+} lv_mutex_t;
+
+typedef struct {
+    SemaphoreHandle_t signal;   /*Binary - a signal given before the wait is kept*/
+} lv_thread_sync_t;
+
+#endif /*LV_OS_ESP32_H*/
@@ -11,4 +11,6 @@
 #define ENCODER_B      GPIO_NUM_40
 
 #define HOLD_PIN       GPIO_NUM_46
+
+#define BATTERY_ALERT_PIN GPIO_NUM_NC  // MAX17048 ALRT (open drain), GPIO_NUM_NC = not wired
 #endif // PIN_CONFIG_H
\ No newline at end of file
@@ -1,5 +1,6 @@
 import os
 import gzip
+import hashlib
 import subprocess
 from pathlib import Path
 
@@ -9,13 +10,33 @@ YELLOW  = '\033[0;33m'
 END     = '\033[0m'
 
 ROOT_DIR = os.path.abspath(os.curdir)
+WEB_DIR  = os.path.join(ROOT_DIR, 'src', 'webserver')
+HEADER   = os.path.join(WEB_DIR, 'build', 'assets.h')
 
+# Immutable assets are served under a content hashed URL (/style.<hash>.css) and cached for a year.
+# Pages keep their URL and are revalidated with ETag / If-None-Match.
+# Pages come last - their references to the immutable assets are rewritten to the hashed URLs.
 FILES = [
     {
-        "input":    os.path.join(ROOT_DIR, 'src\\webserver\\index.html'),
-        "header":   os.path.join(ROOT_DIR, 'src\\webserver\\build\\html.h'),
-        "var":      "html",
-        "type":     "html"
+        "input":     os.path.join(WEB_DIR, 'style.css'),
+        "url":       "/style.css",
+        "var":       "style_css",
+        "type":      "text/css",
+        "immutable": True
+    },
+    {
+        "input":     os.path.join(WEB_DIR, 'app.js'),
+        "url":       "/app.js",
+        "var":       "app_js",
+        "type":      "application/javascript",
+        "immutable": True
+    },
+    {
+        "input":     os.path.join(WEB_DIR, 'index.html'),
+        "url":       "/",
+        "var":       "html",
+        "type":      "text/html",
+        "immutable": False
     }
 ]
 
@@ -31,59 +52,79 @@ def minify_asset_minify_exe(src, dst):
         subprocess.run([minifier_path, "-o", dst, src], check=True, capture_output=True)
         return True
     except Exception as e:
-        print(f"{RED}Minify failed: {e}")
+        print(f"{YELLOW}Minify failed, embedding unminified: {e}{END}")
         return False
 
-def gzip_file(input_file, output_file):
-    with open(input_file, 'rb') as f_in:
-        with gzip.open(output_file, 'wb', compresslevel=9) as f_out:
-            f_out.write(f_in.read())
-
-def file_to_header(source_gz, header_file, var_name):
-    with open(source_gz, 'rb') as f:
-        data = f.read()
-
-    with open(header_file, 'w') as f_out:
-        f_out.write(f"const uint8_t {var_name} PROGMEM [] = {{")
-        for i, byte in enumerate(data):
-            if i % 16 == 0:
-                f_out.write("\n  ")
-            f_out.write(f"0x{byte:02x}, ")
-        f_out.write("\n};\n")
-        f_out.write(f"const unsigned int {var_name}_len = {len(data)};\n")
-
-def clean(minified, gzipped):
-    try:
-        os.remove(minified)
-    except Exception as e:
-        print(f"{RED}Failed to remove {minified}: {e}")
+def hashed_url(url, digest):
+    base, ext = os.path.splitext(url)
+    return f"{base}.{digest[:8]}{ext}"
 
-    try:
-        os.remove(gzipped)
-    except Exception as e:
-        print(f"{RED}Failed to remove {gzipped}: {e}")
+def data_to_array(f_out, data, var_name):
+    f_out.write(f"const uint8_t {var_name} PROGMEM [] = {{")
+    for i, byte in enumerate(data):
+        if i % 16 == 0:
+            f_out.write("\n  ")
+        f_out.write(f"0x{byte:02x}, ")
+    f_out.write("\n};\n")
+    f_out.write(f"const unsigned int {var_name}_len = {len(data)};\n\n")
 
-def process_file(entry):
+def process_file(entry, renames):
     src = entry["input"]
     base, ext = os.path.splitext(src)
     minified = base + ".min" + ext
-    gzipped = minified + ".gz"
-    header = entry["header"]
-    var = entry["var"]
+    staged = base + ".stage" + ext
 
-    open_or_create(header)
     if not os.path.exists(src):
-        print(f"{RED}Source file not found: {src}")
-        return
+        print(f"{RED}Source file not found: {src}{END}")
+        return None
 
-    if minify_asset_minify_exe(src, minified):
-        gzip_file(minified, gzipped)
-        file_to_header(gzipped, header, var)
-        print(f"Embedding {var}:\t\t" + GREEN + "SUCCESS" + END + f" ({os.path.getsize(gzipped)} bytes)")
+    # Point pages at the hashed asset URLs
+    with open(src, 'r', encoding='utf-8') as f:
+        text = f.read()
+    for old, new in renames.items():
+        text = text.replace(f'"{old}"', f'"{new}"')
+    with open(staged, 'w', encoding='utf-8') as f:
+        f.write(text)
+
+    if minify_asset_minify_exe(staged, minified):
+        with open(minified, 'rb') as f:
+            raw = f.read()
+        os.remove(minified)
     else:
-        print(f"Embedding {var}:\t\t" + RED + "FAILED")
+        raw = text.encode('utf-8')
+    os.remove(staged)
+
+    # mtime=0 - same input, same bytes, same ETag
+    data = gzip.compress(raw, compresslevel=9, mtime=0)
+    digest = hashlib.sha256(data).hexdigest()
+
+    url = entry["url"]
+    if entry["immutable"]:
+        url = hashed_url(url, digest)
+        renames[entry["url"]] = url
+
+    print(f"Embedding {entry['var']}:\t\t" + GREEN + "SUCCESS" + END + f" ({len(data)} bytes, {url})")
+    return {"entry": entry, "url": url, "data": data, "etag": digest[:16]}
+
+def write_header(assets):
+    open_or_create(HEADER)
+    with open(HEADER, 'w') as f_out:
+        f_out.write("// Generated by script/embed_html.py - do not edit\n#pragma once\n\n")
+        for asset in assets:
+            data_to_array(f_out, asset["data"], asset["entry"]["var"])
 
-    clean(minified, gzipped)
+        f_out.write("const EmbeddedAsset embedded_assets[] = {\n")
+        for asset in assets:
+            entry = asset["entry"]
+            f_out.write(f'    {{"{asset["url"]}", "{entry["type"]}", {entry["var"]}, {entry["var"]}_len, '
+                        f'"\\"{asset["etag"]}\\"", {"true" if entry["immutable"] else "false"}}},\n')
+        f_out.write("};\n")
+        f_out.write("const size_t embedded_assets_count = sizeof(embedded_assets) / sizeof(embedded_assets[0]);\n")
 
+renames = {}
+assets = []
 for entry in FILES:
-    process_file(entry)
\ No newline at end of file
+    asset = process_file(entry, renames)
+    if asset is not None:
+        assets.append(asset)
+write_header(assets)
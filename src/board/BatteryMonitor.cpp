@@ -0,0 +1,108 @@
+#include "BatteryMonitor.h"
+#include "dev_tools.h"
+#include "driver/gpio.h"
+
+BatteryMonitor::BatteryMonitor() { }
+
+BatteryMonitor::~BatteryMonitor() {
+    if (BATTERY_ALERT_PIN != GPIO_NUM_NC) {
+        gpio_isr_handler_remove(BATTERY_ALERT_PIN);
+    }
+    delete lipo;
+    lipo = nullptr;
+}
+
+void IRAM_ATTR BatteryMonitor::AlertIsr(void* arg) {
+    static_cast<BatteryMonitor*>(arg)->alert = true;
+}
+
+bool BatteryMonitor::begin(TwoWire* wire) {
+    lipo = new Adafruit_MAX17048();
+    if (!lipo->begin(wire)) {
+        delete lipo;
+        lipo = nullptr;
+        DEBUG_PRINTLN("[Battery] Failed to initialize MAX17048");
+        return false;
+    }
+
+    // Alert on every 1% change and on voltage limits - handled at the next update()
+    lipo->setAlertVoltages(BATTERY_ALERT_VMIN, BATTERY_ALERT_VMAX);
+    lipo->enableSOCchangeAlert(true);
+    lipo->clearAlertFlag(lipo->getAlertStatus());
+
+    if (BATTERY_ALERT_PIN != GPIO_NUM_NC) {
+        gpio_reset_pin(BATTERY_ALERT_PIN);
+        gpio_set_direction(BATTERY_ALERT_PIN, GPIO_MODE_INPUT);
+        gpio_set_pull_mode(BATTERY_ALERT_PIN, GPIO_PULLUP_ONLY);
+        gpio_set_intr_type(BATTERY_ALERT_PIN, GPIO_INTR_NEGEDGE);
+
+        esp_err_t ret = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+        if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+            DEBUG_PRINTLN("[Battery] Failed to install GPIO ISR service");
+        }
+        gpio_isr_handler_add(BATTERY_ALERT_PIN, BatteryMonitor::AlertIsr, this);
+    }
+
+    return true;
+}
+
+int BatteryMonitor::computeBucket(int percent) const {
+    int max_bucket = 100 / BATTERY_BUCKET_SIZE;
+    int target = percent / BATTERY_BUCKET_SIZE;
+    if (target > max_bucket) target = max_bucket;
+    if (target < 0) target = 0;
+
+    if (bucket < 0 || target == bucket) {
+        return target;
+    }
+
+    // Leave the current bucket only once past its edge by the hysteresis
+    if (target > bucket && percent >= target * BATTERY_BUCKET_SIZE + BATTERY_HYSTERESIS) {
+        return target;
+    }
+    if (target < bucket && percent < bucket * BATTERY_BUCKET_SIZE - BATTERY_HYSTERESIS) {
+        return target;
+    }
+    return bucket;
+}
+
+bool BatteryMonitor::update(uint32_t now_ms) {
+    if (lipo == nullptr) {
+        return false;
+    }
+
+    bool alerted = alert;
+    if (sampled && !alerted && (now_ms - last_sample) < BATTERY_SAMPLE_PERIOD) {
+        return false;
+    }
+    alert = false;
+    last_sample = now_ms;
+
+    if (alerted) {
+        uint8_t status = lipo->getAlertStatus();
+        lipo->clearAlertFlag(status);
+        DEBUG_PRINTLN("[Battery] Alert: " << (int)status);
+    }
+
+    float percent = lipo->cellPercent();
+    if (percent < 0.0f) percent = 0.0f;
+    if (percent > 100.0f) percent = 100.0f;
+    int32_t sample = (int32_t)(percent * 256.0f);
+
+    // First sample seeds the filter, later ones are smoothed
+    if (!sampled) {
+        filtered = sample;
+        sampled = true;
+    } else {
+        filtered += (sample - filtered) >> BATTERY_FILTER_SHIFT;
+    }
+
+    int next = computeBucket(getPercent());
+    if (next == bucket) {
+        return false;
+    }
+
+    DEBUG_PRINTLN("[Battery] " << getPercent() << "% - bucket " << bucket << " -> " << next);
+    bucket = next;
+    return true;
+}
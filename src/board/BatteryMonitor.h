@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Wire.h>
+#include "Adafruit_MAX1704X.h"
+#include "../include/pin_config.h"
+#include "../include/display_config.h"
+
+/**
+ * @brief Low rate MAX17048 sampling with filtering and display buckets
+ *
+ * The fuel gauge is read once per BATTERY_SAMPLE_PERIOD, or right away when
+ * the chip raises its alert (1% SOC change, voltage thresholds). Samples are
+ * smoothed and mapped to BATTERY_BUCKET_SIZE buckets with hysteresis, so the
+ * UI only changes when the displayed icon would.
+ */
+class BatteryMonitor {
+private:
+    Adafruit_MAX17048* lipo = nullptr;
+
+    volatile bool alert     = false;    // Set by the ALRT interrupt
+    uint32_t last_sample    = 0;
+    bool sampled            = false;
+    int32_t filtered        = 0;        // Smoothed charge [% * 256]
+    int bucket              = -1;
+
+    static void IRAM_ATTR AlertIsr(void* arg);
+
+    // Bucket for the filtered charge, sticking to the current one within the hysteresis
+    int computeBucket(int percent) const;
+
+public:
+    BatteryMonitor();
+    ~BatteryMonitor();
+
+    /**
+     * @brief Initialize the fuel gauge and its alert
+     * @return false if no MAX17048 answered
+     */
+    bool begin(TwoWire* wire);
+
+    bool isAvailable(void) const { return lipo != nullptr; }
+
+    /**
+     * @brief Sample if the period elapsed or the alert fired
+     * @param now_ms current time
+     * @return true if the displayed bucket changed
+     */
+    bool update(uint32_t now_ms);
+
+    // Filtered charge [%]
+    int getPercent(void) const { return filtered >> 8; }
+
+    // Representative charge of the current bucket for the dashboard [%]
+    int getDisplayValue(void) const { return bucket * BATTERY_BUCKET_SIZE; }
+};
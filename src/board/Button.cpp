@@ -0,0 +1,98 @@
+#include "Button.h"
+#include "dev_tools.h"
+#include "../notify/Metrics.h"
+#include "driver/gpio.h"
+#include "hal/gpio_ll.h"
+
+static ButtonFsm::Config fsm_config(void) {
+    ButtonFsm::Config config;
+    config.debounce_ms    = BUTTON_DEBOUNCE;
+    config.click_gap_ms   = BUTTON_CLICK_GAP;
+    config.long_press_ms  = BUTTON_LONG_PRESS;
+    config.hold_repeat_ms = BUTTON_HOLD_REPEAT;
+    return config;
+}
+
+Button::Button(gpio_num_t pin) : pin(pin), fsm(fsm_config()) { }
+
+Button::~Button() {
+    gpio_isr_handler_remove(pin);
+    if (timer != nullptr) {
+        xTimerDelete(timer, 0);
+        timer = nullptr;
+    }
+    if (events != nullptr) {
+        vQueueDelete(events);
+        events = nullptr;
+    }
+}
+
+bool Button::begin(void) {
+    events = xQueueCreate(BUTTON_EVENT_QUEUE, sizeof(ButtonEvent));
+    timer = xTimerCreate("Button", pdMS_TO_TICKS(BUTTON_DEBOUNCE), pdFALSE, this, TimerCallback);
+    if (events == nullptr || timer == nullptr) {
+        DEBUG_PRINTLN("[Button] Failed to create timer / queue");
+        return false;
+    }
+
+    gpio_set_intr_type(pin, GPIO_INTR_ANYEDGE);
+    esp_err_t ret = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        DEBUG_PRINTLN("[Button] Failed to install GPIO ISR service");
+        return false;
+    }
+    gpio_isr_handler_add(pin, Button::EdgeIsr, this);
+
+    // Button held during boot
+    if (isDown()) {
+        fsm.edge(pdTICKS_TO_MS(xTaskGetTickCount()), true);
+        xTimerStart(timer, 0);
+    }
+    return true;
+}
+
+void IRAM_ATTR Button::EdgeIsr(void* arg) {
+    Button* instance = static_cast<Button*>(arg);
+    instance->edge_level = (gpio_ll_get_level(&GPIO, instance->pin) == 0);
+    instance->edge_time = pdTICKS_TO_MS(xTaskGetTickCountFromISR());
+    instance->edge_pending = true;
+
+    // Restart the debounce time on every bounce
+    BaseType_t woken = pdFALSE;
+    xTimerChangePeriodFromISR(instance->timer, pdMS_TO_TICKS(BUTTON_DEBOUNCE), &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void Button::TimerCallback(TimerHandle_t timer) {
+    Button* instance = static_cast<Button*>(pvTimerGetTimerID(timer));
+    uint32_t now = pdTICKS_TO_MS(xTaskGetTickCount());
+
+    // Clear first - an edge during the callback re-arms the timer and is handled next time
+    if (instance->edge_pending) {
+        instance->edge_pending = false;
+        instance->fsm.edge(instance->edge_time, instance->edge_level);
+    }
+
+    ButtonFsm::Events out;
+    instance->fsm.tick(now, out);
+    for (uint8_t i = 0; i < out.count; i++) {
+        if (xQueueSend(instance->events, &out.items[i], 0) != pdTRUE) {
+            DEBUG_PRINTLN("[Button] Event queue full, event dropped");
+            Metrics::getInstance().drop(MetricQueue::BUTTON);
+        }
+    }
+
+    // Sleep until the next click gap / long press / hold deadline
+    uint32_t deadline;
+    if (instance->fsm.getDeadline(deadline)) {
+        int32_t delay = (int32_t)(deadline - now);
+        xTimerChangePeriod(timer, delay > 0 ? pdMS_TO_TICKS(delay) : 1, 0);
+    }
+}
+
+bool Button::getEvent(ButtonEvent& event) {
+    if (events == nullptr) {
+        return false;
+    }
+    return xQueueReceive(events, &event, 0) == pdTRUE;
+}
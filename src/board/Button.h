@@ -0,0 +1,54 @@
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/timers.h"
+#include "../include/pin_config.h"
+#include "ButtonFsm.h"
+
+#define BUTTON_DEBOUNCE         20      // [ms]
+#define BUTTON_CLICK_GAP        300     // Max pause between clicks of a multi-click [ms]
+#define BUTTON_LONG_PRESS       1000    // [ms]
+#define BUTTON_HOLD_REPEAT      1000    // HOLD event period while held [ms]
+#define BUTTON_EVENT_QUEUE      8
+
+/**
+ * @brief Push button driven by its GPIO interrupt and a one-shot timer
+ *
+ * The edge interrupt only stores the level and (re)arms the timer for the
+ * debounce time. The timer callback runs ButtonFsm and re-arms itself for
+ * the next FSM deadline (click gap, long press, hold repeat), so nothing
+ * polls the pin. Events are read from a queue with getEvent().
+ */
+class Button {
+private:
+    gpio_num_t pin;
+    ButtonFsm fsm;
+    TimerHandle_t timer   = nullptr;
+    QueueHandle_t events  = nullptr;
+
+    // Written by the edge interrupt
+    volatile bool edge_level      = false;
+    volatile uint32_t edge_time   = 0;
+    volatile bool edge_pending    = false;
+
+    static void IRAM_ATTR EdgeIsr(void* arg);
+    static void TimerCallback(TimerHandle_t timer);
+
+public:
+    Button(gpio_num_t pin = BUTTON_PIN);
+    ~Button();
+
+    /**
+     * @brief Attach the interrupt and start detecting events
+     */
+    bool begin(void);
+
+    /**
+     * @brief Get the next event (non-blocking)
+     */
+    bool getEvent(ButtonEvent& event);
+
+    // Raw level, no debouncing
+    bool isDown(void) const { return gpio_get_level(pin) == 0; }
+};
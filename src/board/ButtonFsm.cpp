@@ -0,0 +1,79 @@
+#include "ButtonFsm.h"
+
+ButtonFsm::ButtonFsm() { }
+ButtonFsm::ButtonFsm(const Config& config) : config(config) { }
+ButtonFsm::~ButtonFsm() { }
+
+void ButtonFsm::edge(uint32_t now_ms, bool level_pressed) {
+    if (level_pressed == raw) {
+        return;
+    }
+    raw = level_pressed;
+    raw_since = now_ms;
+}
+
+void ButtonFsm::tick(uint32_t now_ms, Events& out) {
+    // Debounced level change
+    if (raw != pressed && reached(now_ms, raw_since + config.debounce_ms)) {
+        pressed = raw;
+
+        if (pressed) {
+            press_time = now_ms;
+            next_hold = now_ms + config.long_press_ms;
+            long_active = false;
+            out.push(ButtonEvent::Type::PRESS, clicks, 0);
+        }
+        else {
+            uint32_t held = now_ms - press_time;
+            out.push(ButtonEvent::Type::RELEASE, clicks, held);
+
+            if (long_active) {
+                long_active = false;
+                out.push(ButtonEvent::Type::LONG_RELEASE, 0, held);
+            }
+            else {
+                release_time = now_ms;
+                if (++clicks >= config.max_clicks) {
+                    out.push(ButtonEvent::Type::CLICK, clicks, 0);
+                    clicks = 0;
+                }
+            }
+        }
+    }
+
+    // Long press, then periodic hold events - a long press ends any click sequence
+    if (pressed && reached(now_ms, next_hold)) {
+        uint32_t held = now_ms - press_time;
+        if (!long_active) {
+            long_active = true;
+            clicks = 0;
+            out.push(ButtonEvent::Type::LONG_PRESS, 0, held);
+        }
+        else {
+            out.push(ButtonEvent::Type::HOLD, 0, held);
+        }
+        next_hold += config.hold_repeat_ms;
+    }
+
+    // No further press within the gap - the click sequence is complete
+    if (!pressed && clicks > 0 && reached(now_ms, release_time + config.click_gap_ms)) {
+        out.push(ButtonEvent::Type::CLICK, clicks, 0);
+        clicks = 0;
+    }
+}
+
+bool ButtonFsm::getDeadline(uint32_t& deadline_ms) const {
+    if (raw != pressed) {
+        deadline_ms = raw_since + config.debounce_ms;
+        return true;
+    }
+    if (pressed) {
+        deadline_ms = next_hold;
+        return true;
+    }
+    if (clicks > 0) {
+        deadline_ms = release_time + config.click_gap_ms;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Typed button event
+ */
+struct ButtonEvent {
+    enum class Type : uint8_t {
+        PRESS,          // Debounced press
+        RELEASE,        // Debounced release
+        CLICK,          // Click sequence finished - `clicks` presses
+        LONG_PRESS,     // Held for the long press time
+        HOLD,           // Still held - repeated every hold period
+        LONG_RELEASE    // Released after a long press
+    };
+
+    Type type;
+    uint8_t clicks;     // CLICK: number of clicks in the sequence
+    uint32_t held_ms;   // RELEASE / LONG_PRESS / HOLD / LONG_RELEASE: press duration
+};
+
+/**
+ * @brief Debounce and click / long press detection for a single button
+ *
+ * Driven only by edges and deadlines: edge() records a raw level change,
+ * tick() advances the state at the current time and getDeadline() tells
+ * when tick() has to run next. No hardware access - edge timings can be
+ * simulated on the host.
+ */
+class ButtonFsm {
+public:
+    struct Config {
+        uint32_t debounce_ms    = 20;       // Level must be stable this long
+        uint32_t click_gap_ms   = 300;      // Max release time between clicks of a sequence
+        uint32_t long_press_ms  = 1000;     // Press time of a long press
+        uint32_t hold_repeat_ms = 1000;     // HOLD event period after the long press
+        uint8_t max_clicks      = 10;       // Sequence ends right away at this count
+    };
+
+    static constexpr uint8_t MAX_EVENTS = 4;
+
+    struct Events {
+        ButtonEvent items[MAX_EVENTS];
+        uint8_t count = 0;
+
+        void push(ButtonEvent::Type type, uint8_t clicks, uint32_t held_ms) {
+            if (count < MAX_EVENTS)
+                items[count++] = {type, clicks, held_ms};
+        }
+    };
+
+private:
+    Config config;
+
+    bool raw            = false;    // Last raw level (true = pressed)
+    uint32_t raw_since  = 0;
+    bool pressed        = false;    // Debounced level
+    uint32_t press_time = 0;
+    uint32_t release_time = 0;
+    uint32_t next_hold  = 0;
+    uint8_t clicks      = 0;
+    bool long_active    = false;
+
+    static bool reached(uint32_t now, uint32_t deadline) {
+        return (int32_t)(now - deadline) >= 0;
+    }
+
+public:
+    ButtonFsm();
+    explicit ButtonFsm(const Config& config);
+    ~ButtonFsm();
+
+    /**
+     * @brief Raw level change, may bounce
+     */
+    void edge(uint32_t now_ms, bool level_pressed);
+
+    /**
+     * @brief Advance to now_ms and collect the resulting events
+     */
+    void tick(uint32_t now_ms, Events& out);
+
+    /**
+     * @brief Next time tick() has work to do
+     * @return false if the button is idle
+     */
+    bool getDeadline(uint32_t& deadline_ms) const;
+
+    bool isPressed(void) const { return pressed; }
+};
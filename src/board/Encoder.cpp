@@ -1,27 +1,89 @@
 #include "Encoder.h"
+#include "esp_timer.h"
+#include <string.h>
 
-Encoder::Encoder(gpio_num_t pinA, gpio_num_t pinB) : encoder() {
+static EncoderAccel::Config accel_config(void) {
+    EncoderAccel::Config config;
+    config.glitch_us  = ENCODER_GLITCH_US;
+    config.timeout_us = ENCODER_ACCEL_TIMEOUT;
+    config.min_speed  = ENCODER_ACCEL_MIN_SPEED;
+    config.max_speed  = ENCODER_ACCEL_MAX_SPEED;
+    config.max_factor = ENCODER_ACCEL_MAX;
+    return config;
+}
+
+Encoder::Encoder(gpio_num_t pinA, gpio_num_t pinB) : encoder(true, Encoder::isr, this), accel(accel_config()) {
     gpio_set_pull_mode(pinA, GPIO_PULLUP_ONLY);
     gpio_set_pull_mode(pinB, GPIO_PULLUP_ONLY);
 
     encoder.attachHalfQuad(pinA, pinB);
+    encoder.setFilter(ENCODER_FILTER);
     encoder.clearCount();
     last_position = 0;
 }
 Encoder::~Encoder() { }
 
+void IRAM_ATTR Encoder::isr(void* arg) {
+    Encoder* instance = static_cast<Encoder*>(arg);
+    uint32_t now = (uint32_t)esp_timer_get_time();
+
+    portENTER_CRITICAL_ISR(&instance->lock);
+    int64_t count = instance->encoder.count;
+    int64_t delta = count - instance->isr_count;
+    instance->isr_count = count;
+
+    while (delta != 0) {
+        int8_t direction = delta > 0 ? 1 : -1;
+        if (instance->detent_count < ENCODER_EVENT_QUEUE) {
+            instance->detents[instance->detent_count++] = {now, direction};
+        } else {
+            instance->overflow_steps += direction;
+        }
+        delta -= direction;
+    }
+    portEXIT_CRITICAL_ISR(&instance->lock);
+}
+
 int32_t Encoder::getPosition() {
     return encoder.getCount();
 }
 
+EncoderBatch Encoder::poll() {
+    Detent pending[ENCODER_EVENT_QUEUE];
+    uint8_t count;
+    int32_t overflow;
+
+    portENTER_CRITICAL(&lock);
+    count = detent_count;
+    memcpy(pending, detents, count * sizeof(Detent));
+    detent_count = 0;
+    overflow = overflow_steps;
+    overflow_steps = 0;
+    portEXIT_CRITICAL(&lock);
+
+    EncoderBatch batch;
+    for (uint8_t i = 0; i < count; i++) {
+        accel.feed(pending[i].time_us, pending[i].direction, batch);
+    }
+    batch.steps += overflow;
+    batch.accelerated += overflow;
+
+    last_position = getPosition();
+    return batch;
+}
+
 int32_t Encoder::getDiff() {
-    int32_t current_position = encoder.getCount();
-    int32_t diff = current_position - last_position;
-    last_position = current_position;
-    return diff;
+    return poll().accelerated;
 }
 
 void Encoder::reset() {
+    portENTER_CRITICAL(&lock);
     encoder.clearCount();
+    isr_count = 0;
+    detent_count = 0;
+    overflow_steps = 0;
+    portEXIT_CRITICAL(&lock);
+
+    accel.reset();
     last_position = 0;
 }
@@ -1,20 +1,54 @@
 #pragma once
 
 #include "ESP32Encoder.h"
+#include "freertos/FreeRTOS.h"
 #include "../include/pin_config.h"
+#include "../include/display_config.h"
+#include "EncoderAccel.h"
 // #include "driver/gpio.h"
 
+/**
+ * @brief Rotary encoder with timestamped detents and acceleration
+ *
+ * The PCNT interrupt fires on every count change and stores a timestamp per
+ * detent. poll() hands the detents collected since the last call to
+ * EncoderAccel, so the velocity does not depend on the LVGL polling rate.
+ */
 class Encoder {
 private:
+    struct Detent {
+        uint32_t time_us;
+        int8_t direction;
+    };
+
     ESP32Encoder encoder;
+    EncoderAccel accel;
     int32_t last_position = 0;
 
+    // Written by the PCNT interrupt
+    portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+    Detent detents[ENCODER_EVENT_QUEUE];
+    uint8_t detent_count = 0;
+    int32_t overflow_steps = 0;         // Detents that did not fit the queue - passed on unaccelerated
+    int64_t isr_count = 0;
+
+    static void IRAM_ATTR isr(void* arg);
+
 public:
     Encoder(gpio_num_t pinA = ENCODER_A, gpio_num_t pinB = ENCODER_B);
     ~Encoder();
 
     int32_t getPosition();
+
+    /**
+     * @brief Detents since the last call, accelerated
+     */
     int32_t getDiff();
+
+    /**
+     * @brief Detents since the last call with timing and velocity
+     */
+    EncoderBatch poll();
+
     void reset();
 };
-
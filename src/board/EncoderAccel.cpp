@@ -0,0 +1,76 @@
+#include "EncoderAccel.h"
+
+EncoderAccel::EncoderAccel() { }
+EncoderAccel::EncoderAccel(const Config& config) : config(config) { }
+EncoderAccel::~EncoderAccel() { }
+
+void EncoderAccel::reset(void) {
+    last_us = 0;
+    last_direction = 0;
+    bounce = false;
+    velocity = 0;
+    remainder = 0;
+}
+
+uint32_t EncoderAccel::factor(void) const {
+    if (velocity <= config.min_speed || config.max_speed <= config.min_speed) {
+        return 256;
+    }
+    if (velocity >= config.max_speed) {
+        return config.max_factor * 256;
+    }
+    return 256 + (velocity - config.min_speed) * (config.max_factor - 1) * 256 / (config.max_speed - config.min_speed);
+}
+
+void EncoderAccel::feed(uint32_t time_us, int8_t direction, EncoderBatch& batch) {
+    if (direction == 0) {
+        return;
+    }
+    direction = direction > 0 ? 1 : -1;
+
+    uint32_t dt = time_us - last_us;
+    bool first = (last_direction == 0) || dt > config.timeout_us;
+
+    // Contact bounce - a quick reversal and the step back are both dropped
+    if (!first && dt < config.glitch_us) {
+        if (direction != last_direction && !bounce) {
+            bounce = true;
+            last_us = time_us;
+            batch.glitches++;
+            return;
+        }
+        if (direction == last_direction && bounce) {
+            bounce = false;
+            last_us = time_us;
+            batch.glitches++;
+            return;
+        }
+    }
+    bounce = false;
+
+    // Velocity - smoothed 1/dt, restarted after a pause or a reversal
+    if (first || direction != last_direction) {
+        velocity = 0;
+        remainder = 0;
+    }
+    else {
+        uint32_t instant = 1000000 / (dt ? dt : 1);
+        velocity = (velocity + instant) / 2;
+    }
+    last_us = time_us;
+    last_direction = direction;
+
+    // Accelerated steps in 1/256 - the fraction carries over to the next detent
+    remainder += direction * (int32_t)factor();
+    int32_t steps = remainder / 256;
+    remainder -= steps * 256;
+
+    if (batch.count == 0) {
+        batch.first_us = time_us;
+    }
+    batch.count++;
+    batch.last_us = time_us;
+    batch.steps += direction;
+    batch.accelerated += steps;
+    batch.velocity = velocity;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Detents collected since the last poll
+ */
+struct EncoderBatch {
+    int32_t steps       = 0;    // Raw detents after glitch filtering
+    int32_t accelerated = 0;    // Detents scaled by the acceleration curve
+    uint32_t velocity   = 0;    // Smoothed speed at the last detent [detents/s]
+    uint16_t count      = 0;    // Timestamped detents in the batch
+    uint16_t glitches   = 0;    // Detents rejected as contact bounce
+    uint32_t first_us   = 0;    // Timestamp of the first / last detent
+    uint32_t last_us    = 0;
+};
+
+/**
+ * @brief Velocity estimation and acceleration for timestamped encoder detents
+ *
+ * Fed with one (timestamp, direction) pair per detent. Slow turns map 1:1,
+ * fast spins are multiplied along a linear curve between min_speed and
+ * max_speed. A direction reversal faster than glitch_us is treated as contact
+ * bounce. No hardware access - detent timings can be replayed on the host.
+ */
+class EncoderAccel {
+public:
+    struct Config {
+        uint32_t glitch_us    = 2000;     // Reversals closer than this are bounce
+        uint32_t timeout_us   = 200000;   // Pause that resets the velocity
+        uint32_t min_speed    = 10;       // Below this speed no acceleration [detents/s]
+        uint32_t max_speed    = 60;       // Speed of the maximum multiplier [detents/s]
+        uint32_t max_factor   = 8;        // Maximum multiplier
+    };
+
+private:
+    Config config;
+
+    uint32_t last_us      = 0;
+    int8_t last_direction = 0;
+    bool bounce           = false;    // Last detent was rejected as bounce
+    uint32_t velocity     = 0;        // Smoothed speed [detents/s]
+    int32_t remainder     = 0;        // Fraction of an accelerated step [1/256]
+
+    uint32_t factor(void) const;      // Current multiplier [1/256]
+
+public:
+    EncoderAccel();
+    explicit EncoderAccel(const Config& config);
+    ~EncoderAccel();
+
+    /**
+     * @brief Process one detent and add it to the batch
+     * @param time_us detent timestamp (wraps, only differences are used)
+     * @param direction +1 or -1
+     */
+    void feed(uint32_t time_us, int8_t direction, EncoderBatch& batch);
+
+    void reset(void);
+
+    uint32_t getVelocity(void) const { return velocity; }
+};
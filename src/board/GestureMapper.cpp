@@ -0,0 +1,46 @@
+#include "GestureMapper.h"
+
+GestureMapper::GestureMapper() { }
+GestureMapper::~GestureMapper() { }
+
+bool GestureMapper::feed(const uint8_t* regs, VolumioCommand& cmd) {
+    if (regs == nullptr) {
+        return false;
+    }
+    return update(regs[REG_GESTURE], regs[REG_POINTS] & 0x0F, cmd);
+}
+
+bool GestureMapper::update(uint8_t gesture, uint8_t points, VolumioCommand& cmd) {
+    // Touch ended
+    if (points == 0 && gesture == static_cast<uint8_t>(Gesture::NONE)) {
+        fired = false;
+        return false;
+    }
+
+    // One command per touch - the id stays set while the finger is down
+    if (fired || !map(gesture, cmd)) {
+        return false;
+    }
+
+    fired = true;
+    return true;
+}
+
+bool GestureMapper::map(uint8_t gesture, VolumioCommand& cmd) {
+    switch (static_cast<Gesture>(gesture)) {
+        case Gesture::MOVE_LEFT:
+            cmd = {VolumioCommandType::NEXT, 0};
+            return true;
+        case Gesture::MOVE_RIGHT:
+            cmd = {VolumioCommandType::PREV, 0};
+            return true;
+        case Gesture::MOVE_UP:
+            cmd = {VolumioCommandType::VOLUME, 1};
+            return true;
+        case Gesture::MOVE_DOWN:
+            cmd = {VolumioCommandType::VOLUME, -1};
+            return true;
+        default:
+            return false;
+    }
+}
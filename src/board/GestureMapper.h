@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include "../notify/CommandQueue.h"
+
+/**
+ * @brief Maps touch controller gestures to player commands
+ *
+ * Fed with the register burst the touch driver already reads (gesture id,
+ * point count, first point), so gestures cost no extra bus traffic and no
+ * coordinate tracking. Each touch produces at most one command. No hardware
+ * access - the mapping can be replayed from recorded register dumps.
+ */
+class GestureMapper {
+public:
+    // Gesture ids as reported in the FT5x06_GESTURE_ID register
+    enum class Gesture : uint8_t {
+        NONE        = 0x00,
+        MOVE_UP     = 0x10,
+        MOVE_LEFT   = 0x14,
+        MOVE_DOWN   = 0x18,
+        MOVE_RIGHT  = 0x1C,
+        ZOOM_IN     = 0x48,
+        ZOOM_OUT    = 0x49
+    };
+
+    // Register dump layout - registers 0x01 (gesture id) .. 0x06 (first point YL)
+    static constexpr uint8_t REG_GESTURE  = 0;
+    static constexpr uint8_t REG_POINTS   = 1;
+    static constexpr uint8_t DUMP_SIZE    = 6;
+
+private:
+    bool fired = false;     // Command already issued for the current touch
+
+public:
+    GestureMapper();
+    ~GestureMapper();
+
+    /**
+     * @brief Feed one register dump
+     * @param regs DUMP_SIZE bytes starting at the gesture id register
+     * @param cmd output command
+     * @return true if the dump completed a gesture and cmd is valid
+     */
+    bool feed(const uint8_t* regs, VolumioCommand& cmd);
+
+    /**
+     * @brief Feed the decoded gesture id and touch point count
+     */
+    bool update(uint8_t gesture, uint8_t points, VolumioCommand& cmd);
+
+    /**
+     * @brief Finger lifted - arm for the next touch
+     */
+    void release(void) { fired = false; }
+
+    // Current touch was consumed by a gesture
+    bool isConsumed(void) const { return fired; }
+
+    /**
+     * @brief Command for a gesture id
+     * @return false for ids without a command (none, zoom)
+     */
+    static bool map(uint8_t gesture, VolumioCommand& cmd);
+};
@@ -0,0 +1,44 @@
+#include "IdleManager.h"
+
+IdleManager::IdleManager() { }
+IdleManager::~IdleManager() { }
+
+bool IdleManager::update(uint32_t inactive_ms) {
+    State previous = state;
+
+    if (inactive_ms >= IDLE_OFF_TIMEOUT) {
+        state = State::OFF;
+    }
+    else if (inactive_ms >= IDLE_DIM_TIMEOUT) {
+        state = State::DIMMED;
+    }
+    else {
+        state = State::ACTIVE;
+    }
+
+    return state != previous;
+}
+
+uint8_t IdleManager::getBrightness(void) const {
+    switch (state) {
+        case State::DIMMED: return BRIGHTNESS_DIMMED;
+        case State::OFF:    return 0;
+        default:            return BRIGHTNESS_ACTIVE;
+    }
+}
+
+uint32_t IdleManager::getFramePeriod(void) const {
+    switch (state) {
+        case State::DIMMED: return 1000 / DISPLAY_FPS_DIMMED;
+        case State::OFF:    return IDLE_WAKE_POLL_PERIOD;
+        default:            return 1000 / DISPLAY_FPS;
+    }
+}
+
+uint32_t IdleManager::getPollPeriod(void) const {
+    switch (state) {
+        case State::DIMMED: return IDLE_POLL_DIMMED;
+        case State::OFF:    return IDLE_POLL_OFF;
+        default:            return 0;
+    }
+}
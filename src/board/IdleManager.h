@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include "../include/display_config.h"
+
+/**
+ * @brief Display inactivity state machine
+ *
+ * ACTIVE -> DIMMED -> OFF based on the time since the last user activity
+ * (touch, encoder, button or a track change). Any activity returns to ACTIVE.
+ * Each state has its own backlight level, render period and Volumio poll
+ * period; in OFF rendering is paused and only the wake-up sources are polled.
+ */
+class IdleManager {
+public:
+    enum class State {
+        ACTIVE,
+        DIMMED,
+        OFF
+    };
+
+private:
+    State state = State::ACTIVE;
+
+public:
+    IdleManager();
+    ~IdleManager();
+
+    /**
+     * @brief Update the state from the inactivity time
+     * @param inactive_ms time since the last activity
+     * @return true if the state changed
+     */
+    bool update(uint32_t inactive_ms);
+
+    State getState(void) const { return state; }
+    bool isRendering(void) const { return state != State::OFF; }
+
+    // Backlight level for the current state
+    uint8_t getBrightness(void) const;
+
+    // Delay between display task iterations for the current state [ms]
+    uint32_t getFramePeriod(void) const;
+
+    // Volumio poll period of the selected player for the current state [ms], 0 = default
+    uint32_t getPollPeriod(void) const;
+};
@@ -0,0 +1,40 @@
+#include "TouchFilter.h"
+
+TouchFilter::Report TouchFilter::feed(const uint8_t* regs) {
+    Report report;
+    if (regs == nullptr || suppressed) {
+        pressed = false;
+        return report;
+    }
+
+    if (gestures.feed(regs, report.cmd)) {
+        // Hold the press where LVGL last saw it and cancel it there
+        report.gesture = true;
+        report.cancel  = true;
+        report.pressed = pressed;
+        report.x       = last_x;
+        report.y       = last_y;
+        suppressed = true;
+        pressed    = false;
+        return report;
+    }
+
+    // Same decoding as FT3267::readPos()
+    uint8_t points = regs[GestureMapper::REG_POINTS] & 0x0F;
+    if (points > 0) {
+        last_x = ((regs[2] & 0x0F) << 8) + regs[3];
+        last_y = ((regs[4] & 0x0F) << 8) + regs[5];
+        report.pressed = true;
+        report.x = last_x;
+        report.y = last_y;
+    }
+    pressed = report.pressed;
+    return report;
+}
+
+TouchFilter::Report TouchFilter::release(void) {
+    gestures.release();
+    suppressed = false;
+    pressed    = false;
+    return Report();
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include "GestureMapper.h"
+
+/**
+ * @brief Decides what each touch controller read reports to LVGL
+ *
+ * Points go through as pressed until the GestureMapper recognizes a swipe.
+ * LVGL has seen the press at the start point by then, and a release would
+ * end it as a normal press - clicking the button or dropping the arc under
+ * it. The gesture read reports the last point again and asks for the press
+ * to be cancelled instead (lv_indev_reset() + lv_indev_wait_release()). The
+ * rest of the touch, and the touch that woke the screen up, report released.
+ *
+ * No hardware access - fed with the register burst of the driver.
+ */
+class TouchFilter {
+public:
+    struct Report {
+        bool pressed    = false;    // Indev state
+        int16_t x       = 0;
+        int16_t y       = 0;
+        bool cancel     = false;    // Drop the press in progress without a release
+        bool gesture    = false;    // cmd holds the gesture's command
+        VolumioCommand cmd;
+    };
+
+private:
+    GestureMapper gestures;
+    bool suppressed = false;    // Rest of the touch is not passed to the UI
+    bool pressed    = false;    // Last report was pressed
+    int16_t last_x  = 0;
+    int16_t last_y  = 0;
+
+public:
+    /**
+     * @brief Feed one register dump (GestureMapper::DUMP_SIZE bytes from the gesture id)
+     */
+    Report feed(const uint8_t* regs);
+
+    /**
+     * @brief Finger lifted - the controller released its interrupt line
+     */
+    Report release(void);
+
+    // Ignore the current touch until it is released (it woke the screen up)
+    void suppress(void) { suppressed = true; }
+    bool isSuppressed(void) const { return suppressed; }
+    bool isPressed(void) const { return pressed; }
+};
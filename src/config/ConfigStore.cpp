@@ -0,0 +1,230 @@
+#include "ConfigStore.h"
+#include <Preferences.h>
+#include "esp_timer.h"
+#include "dev_tools.h"
+#include "wifi_config.h"
+#include <stddef.h>
+#include <string.h>
+
+ConfigStore* ConfigStore::instance = nullptr;
+
+namespace {
+
+struct BlobHeader {
+    uint32_t magic;
+    uint32_t crc;
+    uint16_t length;
+    uint16_t reserved;
+};
+
+bool put_string(const std::string& value, uint8_t* out, size_t size, size_t& pos) {
+    if (value.size() > 255 || pos + 1 + value.size() > size) {
+        return false;
+    }
+    out[pos++] = (uint8_t)value.size();
+    memcpy(out + pos, value.data(), value.size());
+    pos += value.size();
+    return true;
+}
+
+bool get_string(const uint8_t* data, size_t len, size_t& pos, std::string& value) {
+    if (pos >= len || pos + 1 + data[pos] > len) {
+        return false;
+    }
+    value.assign((const char*)data + pos + 1, data[pos]);
+    pos += 1 + data[pos];
+    return true;
+}
+
+}
+
+uint32_t ConfigStore::crc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+size_t ConfigStore::encode(const Config& config, uint8_t* out, size_t size) {
+    size_t pos = sizeof(BlobHeader);
+    if (size < pos ||
+        !put_string(config.ssid, out, size, pos) ||
+        !put_string(config.password, out, size, pos) ||
+        !put_string(config.volumio, out, size, pos)) {
+        return 0;
+    }
+
+    BlobHeader header = {CONFIG_MAGIC, crc32(out + sizeof(BlobHeader), pos - sizeof(BlobHeader)),
+                         (uint16_t)(pos - sizeof(BlobHeader)), 0};
+    memcpy(out, &header, sizeof(header));
+    return pos;
+}
+
+bool ConfigStore::decode(const uint8_t* data, size_t len, Config& config) {
+    BlobHeader header;
+    if (len < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != CONFIG_MAGIC || sizeof(header) + header.length != len ||
+        crc32(data + sizeof(header), header.length) != header.crc) {
+        return false;
+    }
+
+    Config decoded;
+    size_t pos = sizeof(header);
+    if (!get_string(data, len, pos, decoded.ssid) ||
+        !get_string(data, len, pos, decoded.password) ||
+        !get_string(data, len, pos, decoded.volumio)) {
+        return false;
+    }
+    config = decoded;
+    return true;
+}
+
+ConfigStore::ConfigStore() {
+    load();
+}
+
+ConfigStore::~ConfigStore() {
+    flush();
+}
+
+ConfigStore& ConfigStore::getInstance() {
+    if (instance == nullptr) {
+        instance = new ConfigStore();
+    }
+    return *instance;
+}
+
+void ConfigStore::load(void) {
+    int64_t start = esp_timer_get_time();
+
+    Preferences preferences;
+    preferences.begin(CONFIG_NAMESPACE, false);
+    #if RESET_PREFERENCES == true
+        preferences.clear();
+        DEBUG_PRINTLN("[Preferences] NVS cleared");
+    #endif
+
+    uint8_t blob[CONFIG_MAX_SIZE];
+    size_t len = preferences.getBytesLength("config");
+    if (len > 0 && len <= sizeof(blob) && preferences.getBytes("config", blob, len) == len && decode(blob, len, config)) {
+        memcpy(&stored_crc, blob + offsetof(BlobHeader, crc), sizeof(stored_crc));
+    }
+    else {
+        // Old layout (one key each) or first boot - rewritten as a blob with the next flush
+        config.ssid     = preferences.getString("ssid", STA_SSID).c_str();
+        config.password = preferences.getString("pass", STA_PASS).c_str();
+        config.volumio  = preferences.getString("ip", VOLUMIO_IP).c_str();
+        stats.migrated  = preferences.isKey("ssid");
+        dirty   = stats.migrated;
+        changed = xTaskGetTickCount();
+    }
+    preferences.end();
+
+    stats.load_us = (uint32_t)(esp_timer_get_time() - start);
+    DEBUG_PRINTLN("[Config] Loaded in " << stats.load_us << " us" << (stats.migrated ? " (migrated)" : ""));
+}
+
+Config ConfigStore::get(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    stats.reads++;
+    return config;
+}
+
+bool ConfigStore::update(const Config& next) {
+    std::vector<Subscriber> notify;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (next == config) {
+            return false;
+        }
+        config  = next;
+        dirty   = true;
+        changed = xTaskGetTickCount();
+        stats.updates++;
+        notify  = subscribers;
+    }
+
+    // Outside the lock - subscribers may call get()
+    for (const Subscriber& subscriber : notify) {
+        subscriber(next);
+    }
+    return true;
+}
+
+void ConfigStore::subscribe(Subscriber subscriber) {
+    std::lock_guard<std::mutex> guard(lock);
+    subscribers.push_back(subscriber);
+}
+
+void ConfigStore::tick(TickType_t now) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!dirty || now - changed < CONFIG_WRITE_DELAY) {
+            return;
+        }
+    }
+    flush();
+}
+
+void ConfigStore::flush(void) {
+    uint8_t blob[CONFIG_MAX_SIZE];
+    size_t len;
+    bool migrated;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!dirty) {
+            return;
+        }
+        dirty = false;
+        migrated = stats.migrated;
+        len = encode(config, blob, sizeof(blob));
+    }
+    if (len == 0) {
+        DEBUG_PRINTLN("[Config] Too large, not saved");
+        return;
+    }
+
+    uint32_t crc;
+    memcpy(&crc, blob + offsetof(BlobHeader, crc), sizeof(crc));
+    if (crc == stored_crc) {
+        // Changed and changed back before the write - nothing to do
+        std::lock_guard<std::mutex> guard(lock);
+        stats.skipped++;
+        return;
+    }
+
+    int64_t start = esp_timer_get_time();
+    Preferences preferences;
+    preferences.begin(CONFIG_NAMESPACE, false);
+    bool written = preferences.putBytes("config", blob, len) == len;
+    if (written && migrated) {
+        preferences.remove("ssid");
+        preferences.remove("pass");
+        preferences.remove("ip");
+    }
+    preferences.end();
+
+    std::lock_guard<std::mutex> guard(lock);
+    if (written) {
+        stored_crc = crc;
+        stats.writes++;
+        stats.migrated = false;
+    } else {
+        dirty   = true;     // Retry after another CONFIG_WRITE_DELAY
+        changed = xTaskGetTickCount();
+    }
+    stats.last_write_us = (uint32_t)(esp_timer_get_time() - start);
+    DEBUG_PRINTLN("[Config] " << (written ? "Saved " : "Save failed, ") << len << " B in " << stats.last_write_us << " us");
+}
+
+ConfigStats ConfigStore::getStats(void) {
+    std::lock_guard<std::mutex> guard(lock);
+    return stats;
+}
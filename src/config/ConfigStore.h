@@ -0,0 +1,120 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define CONFIG_NAMESPACE    "my-app"
+#define CONFIG_WRITE_DELAY  pdMS_TO_TICKS(2000)     // Quiet time before a change is written to NVS
+#define CONFIG_MAGIC        0x43464731              // "CFG1"
+#define CONFIG_MAX_SIZE     512                     // Largest encoded blob [B]
+
+/**
+ * @brief User configuration
+ */
+struct Config {
+    std::string ssid;
+    std::string password;
+    std::string volumio;    // Volumio host list (see WiFiHandler)
+
+    bool operator==(const Config& other) const {
+        return ssid == other.ssid && password == other.password && volumio == other.volumio;
+    }
+    bool operator!=(const Config& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief NVS access counters
+ */
+struct ConfigStats {
+    uint32_t reads          = 0;    // get() calls served from RAM
+    uint32_t updates        = 0;    // Changes accepted by update()
+    uint32_t writes         = 0;    // Blob writes to NVS
+    uint32_t skipped        = 0;    // Flushes that matched the stored CRC
+    uint32_t load_us        = 0;    // Boot load time
+    uint32_t last_write_us  = 0;
+    bool migrated           = false; // Loaded from the old per-key layout
+};
+
+/**
+ * @brief Configuration loaded once from NVS, served from RAM
+ *
+ * update() changes the RAM copy and notifies subscribers right away. The
+ * write to NVS is deferred until no change arrived for CONFIG_WRITE_DELAY
+ * (tick() from the WiFi task) and batches all keys into one CRC-protected
+ * blob. A blob with the same CRC as the stored one is not written again.
+ * A missing or corrupt blob falls back to the old "ssid" / "pass" / "ip" keys
+ * and then to the compiled-in defaults.
+ */
+class ConfigStore {
+public:
+    using Subscriber = std::function<void(const Config&)>;
+
+private:
+    std::mutex lock;
+    Config config;
+    ConfigStats stats;
+    std::vector<Subscriber> subscribers;
+
+    bool dirty          = false;
+    TickType_t changed  = 0;        // Time of the last update()
+    uint32_t stored_crc = 0;        // CRC of the blob in NVS
+
+    static ConfigStore* instance;
+    ConfigStore();
+
+    void load(void);
+
+public:
+    ~ConfigStore();
+
+    ConfigStore(const ConfigStore&) = delete;
+    void operator=(const ConfigStore&) = delete;
+
+    static ConfigStore& getInstance();
+
+#ifdef HOST_BUILD
+    // Host tests - drop the instance (flushing it), the next getInstance() loads NVS again
+    static void resetInstance(void) {
+        delete instance;
+        instance = nullptr;
+    }
+#endif
+
+    Config get(void);
+
+    /**
+     * @brief Replace the configuration - written to NVS after CONFIG_WRITE_DELAY
+     * @return false if nothing changed
+     */
+    bool update(const Config& next);
+
+    /**
+     * @brief Called with the new configuration after every change (caller's task)
+     */
+    void subscribe(Subscriber subscriber);
+
+    /**
+     * @brief Write a pending change once it settled
+     */
+    void tick(TickType_t now);
+
+    /**
+     * @brief Write a pending change now (before sleep / restart)
+     */
+    void flush(void);
+
+    ConfigStats getStats(void);
+
+    // Blob layout: magic, CRC32 of the payload, payload length, payload (length-prefixed strings)
+    static size_t encode(const Config& config, uint8_t* out, size_t size);
+    static bool decode(const uint8_t* data, size_t len, Config& config);
+    static uint32_t crc32(const uint8_t* data, size_t len);
+};
+
+#endif // CONFIG_STORE_H
@@ -99,6 +99,11 @@ namespace FT3267
     };
 
 
+    /** @brief Registers fetched by one burst read - gesture id up to first point Y */
+    #define FT3267_BURST_START          FT5x06_GESTURE_ID
+    #define FT3267_BURST_SIZE           (FT5x06_TOUCH1_YL - FT5x06_GESTURE_ID + 1)
+
+
     struct Config_t
     {
         #ifndef TOUCH_I2C_PORT
@@ -121,6 +126,8 @@ namespace FT3267
             Config_t _cfg;
             uint8_t _data_buffer[7];
             TouchPoint_t _touch_point_buffer;
+            uint8_t _gesture = ft3267_gesture_none;
+            uint32_t _read_count = 0;
 
 
             inline esp_err_t _writr_reg(uint8_t reg, uint8_t data)
@@ -167,6 +174,9 @@ namespace FT3267
                 // Timer to enter 'idle' when in 'Monitor' (ms)
                 _writr_reg(FT5x06_ID_G_PERIODMONITOR, 40);
 
+                // Interrupt polling mode - INT stays low as long as the panel is touched
+                _writr_reg(FT5x06_ID_G_MODE, 0);
+
                 // _read_reg(0x90, 1);
                 // printf("0x%X\n", _data_buffer[0]);
                 // _read_reg(FT5x06_ID_G_FIRMID, 1);
@@ -201,7 +211,11 @@ namespace FT3267
                     .sda_pullup_en = GPIO_PULLUP_ENABLE,
                     .scl_pullup_en = GPIO_PULLUP_ENABLE,
                     .master = {
-                        .clk_speed = 100000,
+                        #ifndef TOUCH_I2C_FREQ
+                            .clk_speed = 100000,
+                        #else
+                            .clk_speed = TOUCH_I2C_FREQ,
+                        #endif
                     },
                     .clk_flags = 0,
                 };
@@ -233,29 +247,71 @@ namespace FT3267
             }
 
 
+            /**
+             * @brief Read gesture, point count and first point in a single I2C transaction
+             *
+             * @return const TouchPoint_t& - x / y are -1 when not touched or on bus error
+             */
             inline const TouchPoint_t& readPos()
             {
                 _touch_point_buffer.touch_num = 0;
                 _touch_point_buffer.x = -1;
                 _touch_point_buffer.y = -1;
 
-                /* Get touch num */
-                _read_reg(FT5x06_TOUCH_POINTS, 1);
-                _data_buffer[0] = _data_buffer[0] & 0x0F;
-                _touch_point_buffer.touch_num = _data_buffer[0];
+                _read_count++;
+                if (_read_reg(FT3267_BURST_START, FT3267_BURST_SIZE) != ESP_OK)
+                {
+                    memset(_data_buffer, 0, sizeof(_data_buffer));
+                    _gesture = ft3267_gesture_none;
+                    return _touch_point_buffer;
+                }
+
+                /* Buffer holds registers 0x01 (gesture) .. 0x06 (YL) */
+                _gesture = _data_buffer[0];
+                _touch_point_buffer.touch_num = _data_buffer[1] & 0x0F;
 
-                /* Get postion */
-                if (_data_buffer[0] != 0)
+                if (_touch_point_buffer.touch_num != 0)
                 {
-                    _read_reg(FT5x06_TOUCH1_XH, 4);
-                    _touch_point_buffer.x = ((_data_buffer[0] & 0x0f) << 8) + _data_buffer[1];
-                    _touch_point_buffer.y = ((_data_buffer[2] & 0x0f) << 8) + _data_buffer[3];
+                    _touch_point_buffer.x = ((_data_buffer[2] & 0x0f) << 8) + _data_buffer[3];
+                    _touch_point_buffer.y = ((_data_buffer[4] & 0x0f) << 8) + _data_buffer[5];
                 }
 
                 return _touch_point_buffer;
             }
 
 
+            /**
+             * @brief Level of the INT line - low while touched, no bus access
+             */
+            inline bool isIrqActive()
+            {
+                return gpio_get_level(static_cast<gpio_num_t>(TOUCH_IRQ)) == 0;
+            }
+
+
+            /**
+             * @brief Gesture id from the last readPos()
+             */
+            inline uint8_t getGesture() { return _gesture; }
+
+
+            /**
+             * @brief Raw registers 0x01 .. 0x06 from the last readPos()
+             */
+            inline const uint8_t* getRegisterDump() { return _data_buffer; }
+
+
+            /**
+             * @brief Number of burst reads since the last call (bus usage statistics)
+             */
+            inline uint32_t takeReadCount()
+            {
+                uint32_t count = _read_count;
+                _read_count = 0;
+                return count;
+            }
+
+
             inline bool isTouched()
             {
                 return (getTouchPointsNum() > 0);
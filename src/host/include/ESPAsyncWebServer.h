@@ -0,0 +1,101 @@
+#pragma once
+
+// Host stand-in for the parts of ESPAsyncWebServer used by EventStream.
+// AsyncEventSource keeps simulated clients instead of TCP connections. Each
+// client's backlog is capped at SSE_MAX_QUEUED_MESSAGES like the library's -
+// a message sent to a full client is dropped. Scenarios connect, drain and
+// disconnect clients themselves.
+#include <stdint.h>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifndef SSE_MAX_QUEUED_MESSAGES
+#define SSE_MAX_QUEUED_MESSAGES 32
+#endif
+
+class AsyncWebHandler {
+public:
+    virtual ~AsyncWebHandler() = default;
+};
+
+struct HostSseMessage {
+    std::string data;
+    std::string event;
+    uint32_t id;
+    uint32_t reconnect;
+};
+
+class AsyncEventSourceClient {
+public:
+    std::deque<HostSseMessage> backlog;     // Queued, not yet written to the socket
+    uint32_t dropped = 0;                   // Lost to a full backlog
+
+    void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0) {
+        if (backlog.size() >= SSE_MAX_QUEUED_MESSAGES) {
+            dropped++;
+            return;
+        }
+        backlog.push_back({message, event != nullptr ? event : "", id, reconnect});
+    }
+
+    // Host: the socket took everything queued
+    std::vector<HostSseMessage> drain(void) {
+        std::vector<HostSseMessage> sent(backlog.begin(), backlog.end());
+        backlog.clear();
+        return sent;
+    }
+};
+
+typedef std::function<void(AsyncEventSourceClient* client)> ArEventHandlerFunction;
+
+class AsyncEventSource : public AsyncWebHandler {
+private:
+    std::string url;
+    std::vector<std::unique_ptr<AsyncEventSourceClient>> clients;
+    ArEventHandlerFunction connectHandler;
+
+public:
+    explicit AsyncEventSource(const char* url) : url(url) { }
+
+    void onConnect(ArEventHandlerFunction handler) { connectHandler = handler; }
+
+    void send(const char* message, const char* event = nullptr, uint32_t id = 0, uint32_t reconnect = 0) {
+        for (auto& client : clients)
+            client->send(message, event, id, reconnect);
+    }
+
+    size_t count(void) const { return clients.size(); }
+    const std::string& getUrl(void) const { return url; }
+
+    // Host: a browser opens the stream
+    AsyncEventSourceClient* connect(void) {
+        clients.emplace_back(new AsyncEventSourceClient());
+        AsyncEventSourceClient* client = clients.back().get();
+        if (connectHandler)
+            connectHandler(client);
+        return client;
+    }
+
+    // Host: the browser goes away - the client is deleted
+    void disconnect(AsyncEventSourceClient* client) {
+        clients.erase(std::remove_if(clients.begin(), clients.end(),
+                                     [client](const std::unique_ptr<AsyncEventSourceClient>& c) { return c.get() == client; }),
+                      clients.end());
+    }
+};
+
+class AsyncWebServer {
+public:
+    std::vector<AsyncWebHandler*> handlers;
+
+    explicit AsyncWebServer(uint16_t port) { (void)port; }
+
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler) {
+        handlers.push_back(handler);
+        return *handler;
+    }
+};
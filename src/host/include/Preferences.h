@@ -0,0 +1,110 @@
+#pragma once
+
+// Host stand-in for the Arduino Preferences (NVS) API, backed by a map of
+// namespace -> key -> bytes that lives for the whole run. Scenarios inspect
+// and corrupt the stored values, count accesses and make writes fail with the
+// host_nvs_* controls below.
+#include <stdint.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+struct HostNvs {
+    std::map<std::string, std::map<std::string, std::vector<uint8_t>>> spaces;
+    uint32_t opens      = 0;        // begin() calls
+    uint32_t reads      = 0;        // get* / isKey calls
+    uint32_t writes     = 0;        // Successful put* calls
+    uint32_t unchanged  = 0;        // ... of those with the stored value - NVS skips them, no wear
+    bool fail_writes    = false;
+};
+
+inline HostNvs& host_nvs(void) {
+    static HostNvs nvs;
+    return nvs;
+}
+
+inline void host_nvs_clear(void) {
+    host_nvs() = HostNvs();
+}
+
+class Preferences {
+private:
+    std::string space;
+    bool open       = false;
+    bool read_only  = false;
+
+    std::map<std::string, std::vector<uint8_t>>* values(void) {
+        return open ? &host_nvs().spaces[space] : nullptr;
+    }
+
+    const std::vector<uint8_t>* find(const char* key) {
+        host_nvs().reads++;
+        auto* map = values();
+        if (map == nullptr)
+            return nullptr;
+        auto it = map->find(key);
+        return it != map->end() ? &it->second : nullptr;
+    }
+
+    size_t put(const char* key, const void* value, size_t len) {
+        if (!open || read_only || host_nvs().fail_writes)
+            return 0;
+        const uint8_t* bytes = static_cast<const uint8_t*>(value);
+        std::vector<uint8_t>& stored = (*values())[key];
+        if (stored.size() == len && std::equal(stored.begin(), stored.end(), bytes))
+            host_nvs().unchanged++;
+        stored.assign(bytes, bytes + len);
+        host_nvs().writes++;
+        return len;
+    }
+
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        space     = name;
+        open      = true;
+        read_only = readOnly;
+        host_nvs().opens++;
+        return true;
+    }
+
+    void end(void) { open = false; }
+
+    bool clear(void) {
+        if (!open || read_only)
+            return false;
+        values()->clear();
+        return true;
+    }
+
+    bool remove(const char* key) {
+        if (!open || read_only)
+            return false;
+        return values()->erase(key) > 0;
+    }
+
+    bool isKey(const char* key) { return find(key) != nullptr; }
+
+    size_t putBytes(const char* key, const void* value, size_t len) { return put(key, value, len); }
+
+    size_t putString(const char* key, const std::string& value) { return put(key, value.data(), value.size()); }
+
+    size_t getBytesLength(const char* key) {
+        const std::vector<uint8_t>* value = find(key);
+        return value != nullptr ? value->size() : 0;
+    }
+
+    size_t getBytes(const char* key, void* buf, size_t maxLen) {
+        const std::vector<uint8_t>* value = find(key);
+        if (value == nullptr || value->size() > maxLen)
+            return 0;
+        std::copy(value->begin(), value->end(), static_cast<uint8_t*>(buf));
+        return value->size();
+    }
+
+    // Arduino String on the device - both have c_str()
+    std::string getString(const char* key, const std::string& defaultValue = std::string()) {
+        const std::vector<uint8_t>* value = find(key);
+        return value != nullptr ? std::string(value->begin(), value->end()) : defaultValue;
+    }
+};
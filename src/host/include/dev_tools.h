@@ -0,0 +1,7 @@
+#pragma once
+
+// Host build replacement of the device debug helpers - print to stdout
+#include <iostream>
+
+#define DEBUG_PRINT(s)      { std::cout << s; }
+#define DEBUG_PRINTLN(s)    { std::cout << s << std::endl; }
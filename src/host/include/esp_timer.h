@@ -0,0 +1,9 @@
+#pragma once
+
+// esp_timer clock of the host build, from the virtual host_clock
+#include <stdint.h>
+#include "host_clock.h"
+
+inline int64_t esp_timer_get_time(void) {
+    return (int64_t)host_clock_ms() * 1000;
+}
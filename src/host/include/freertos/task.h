@@ -0,0 +1,6 @@
+#pragma once
+
+// Task handle type for the host build - tasks themselves are not emulated
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
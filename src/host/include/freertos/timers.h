@@ -0,0 +1,4 @@
+#pragma once
+
+// Software timers are not used by the host build, only the types are needed
+#include "FreeRTOS.h"
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Virtual millisecond clock of the host build
+ *
+ * Host scenarios advance it explicitly, so timers, animations and timeouts
+ * run the same way on every machine regardless of how fast it renders.
+ */
+inline uint32_t& host_clock_ms(void) {
+    static uint32_t now = 0;
+    return now;
+}
+
+inline void host_clock_advance(uint32_t ms) {
+    host_clock_ms() += ms;
+}
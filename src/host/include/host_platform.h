@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+/**
+ * @brief Controls of the host platform layer (src/host/platform)
+ *
+ * Scenarios plug in the HTTP server stand-in, the names the resolver knows,
+ * the link state and input pin levels. Everything runs on the calling
+ * thread against the virtual host_clock - there is no scheduler, so
+ * platform_task_create() does not start anything and scenarios call the
+ * task's step function themselves.
+ */
+
+// Answers one GET: HTTP status (negative = transport error), body to fill
+typedef std::function<int(const std::string& url, std::string* body)> HostHttpHandler;
+
+void host_http_handler(HostHttpHandler handler);
+void host_net_set(bool connected);
+
+// Answered over mDNS ("name" for "name.local"), DNS and the Volumio DNS-SD browse
+void host_resolver_add(const std::string& name, uint32_t address);
+void host_resolver_clear(void);
+
+// Level returned by platform_gpio_read(), last platform_gpio_write() of a pin
+void host_gpio_set(int pin, int level);
+int host_gpio_get(int pin);
@@ -0,0 +1,7 @@
+#pragma once
+
+// Host build values of the user's wifi_config.h (not part of the repository)
+#define STA_SSID            "host-ssid"
+#define STA_PASS            "host-pass"
+#define VOLUMIO_IP          "volumio.local"
+#define RESET_PREFERENCES   false
@@ -0,0 +1,118 @@
+#include "platform/platform.h"
+#include "volumio/VolumioResolver.h"
+#include "host_platform.h"
+#include "host_clock.h"
+#include <map>
+
+#define HOST_GPIO_COUNT     64
+#define HOST_VOLUMIO_PORT   3000
+
+static HostHttpHandler http_handler;
+static bool net_connected = true;
+static int gpio_levels[HOST_GPIO_COUNT];
+
+/**
+ * @brief ResolverBackend answering from a name table
+ */
+class HostResolverBackend : public ResolverBackend {
+public:
+    std::map<std::string, uint32_t> names;
+
+    uint32_t lookup(const std::string& name) {
+        auto it = names.find(name);
+        return it != names.end() ? it->second : 0;
+    }
+
+    uint32_t queryHost(const std::string& name, uint32_t timeout_ms) override {
+        uint32_t address = lookup(name);
+        if (address == 0)
+            host_clock_advance(timeout_ms);     // A missing host costs the full query timeout
+        return address;
+    }
+
+    uint32_t lookupDns(const std::string& name) override {
+        return lookup(name);
+    }
+
+    // Every name in the table answers as a Volumio service
+    size_t browse(const char* /* service */, const char* /* proto */, uint32_t timeout_ms, std::vector<Service>& found) override {
+        for (const auto& entry : names) {
+            found.push_back({entry.first, entry.second, HOST_VOLUMIO_PORT});
+        }
+        host_clock_advance(timeout_ms);         // Responders are collected for the whole timeout
+        return found.size();
+    }
+};
+
+static HostResolverBackend resolver_backend;
+
+uint32_t platform_millis(void) {
+    return host_clock_ms();
+}
+
+int64_t platform_micros(void) {
+    return (int64_t)host_clock_ms() * 1000;
+}
+
+void platform_delay(uint32_t ms) {
+    host_clock_advance(ms);
+}
+
+// No tasks on the host - a thread would race the scenario on the virtual host_clock.
+// Scenarios call the task's step function (e.g. PlayerManager::Update()) themselves,
+// false tells a caller that nothing runs in the background.
+bool platform_task_create(platform_task_fn /* entry */, const char* /* name */, uint32_t /* stack */,
+                          void* /* param */, uint32_t /* priority */, int /* core */) {
+    return false;
+}
+
+bool platform_net_connected(void) {
+    return net_connected;
+}
+
+int platform_http_get(const std::string& url, std::string* body) {
+    if (!net_connected || !http_handler)
+        return -1;      // HTTPC_ERROR_CONNECTION_REFUSED
+    std::string response;
+    int code = http_handler(url, &response);
+    if (code > 0 && body != nullptr)
+        *body = response;
+    return code;
+}
+
+ResolverBackend& platform_resolver_backend(void) {
+    return resolver_backend;
+}
+
+int platform_gpio_read(int pin) {
+    return (pin >= 0 && pin < HOST_GPIO_COUNT) ? gpio_levels[pin] : 0;
+}
+
+void platform_gpio_write(int pin, int level) {
+    if (pin >= 0 && pin < HOST_GPIO_COUNT)
+        gpio_levels[pin] = level;
+}
+
+void host_http_handler(HostHttpHandler handler) {
+    http_handler = handler;
+}
+
+void host_net_set(bool connected) {
+    net_connected = connected;
+}
+
+void host_resolver_add(const std::string& name, uint32_t address) {
+    resolver_backend.names[name] = address;
+}
+
+void host_resolver_clear(void) {
+    resolver_backend.names.clear();
+}
+
+void host_gpio_set(int pin, int level) {
+    platform_gpio_write(pin, level);
+}
+
+int host_gpio_get(int pin) {
+    return platform_gpio_read(pin);
+}
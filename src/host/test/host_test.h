@@ -0,0 +1,65 @@
+#pragma once
+
+/**
+ * @brief Minimal test harness of the host unit tests (src/host/test)
+ *
+ * TEST(suite, name) registers a test, CHECK / CHECK_EQ record a failure with
+ * its location and let the test continue, so one run reports every broken
+ * expectation. The runner (main.cpp) runs all tests, or the suites named on
+ * the command line, and exits with 1 if anything failed.
+ */
+#include <stdint.h>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+struct HostTest {
+    const char* suite;
+    const char* name;
+    void (*run)(void);
+};
+
+std::vector<HostTest>& host_tests(void);
+void host_test_fail(const char* file, int line, const std::string& message);
+
+struct HostTestRegistrar {
+    HostTestRegistrar(const char* suite, const char* name, void (*run)(void)) {
+        host_tests().push_back({suite, name, run});
+    }
+};
+
+// Printable form of a checked value - enums and bytes as numbers
+template <typename T>
+std::string host_test_str(const T& value) {
+    std::ostringstream out;
+    if constexpr (std::is_enum<T>::value)
+        out << static_cast<long long>(value);
+    else if constexpr (std::is_same<T, bool>::value)
+        out << (value ? "true" : "false");
+    else if constexpr (std::is_same<T, uint8_t>::value || std::is_same<T, int8_t>::value)
+        out << static_cast<int>(value);
+    else
+        out << value;
+    return out.str();
+}
+
+#define TEST(suite, name)                                                                   \
+    static void test_##suite##_##name(void);                                                \
+    static HostTestRegistrar registrar_##suite##_##name(#suite, #name, test_##suite##_##name); \
+    static void test_##suite##_##name(void)
+
+#define CHECK(cond)                                                                         \
+    do {                                                                                    \
+        if (!(cond))                                                                        \
+            host_test_fail(__FILE__, __LINE__, "CHECK(" #cond ")");                         \
+    } while (0)
+
+#define CHECK_EQ(actual, expected)                                                          \
+    do {                                                                                    \
+        const auto& host_actual_   = (actual);                                              \
+        const auto& host_expected_ = (expected);                                            \
+        if (!(host_actual_ == host_expected_))                                              \
+            host_test_fail(__FILE__, __LINE__, "CHECK_EQ(" #actual ", " #expected "): " +   \
+                           host_test_str(host_actual_) + " != " + host_test_str(host_expected_)); \
+    } while (0)
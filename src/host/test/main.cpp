@@ -0,0 +1,54 @@
+/**
+ * @brief Runner of the host unit tests
+ *
+ * The hardware-free classes (input FSMs, Volumio logic, notify queues, web
+ * helpers) are compiled against the shims in src/host/include and driven with
+ * recorded or generated input. Build with the native_test env, which enables
+ * AddressSanitizer and UBSan.
+ *
+ * Usage: program [suite ...]   runs only the named suites
+ * Exit code is 1 if a check failed.
+ */
+#include "host_test.h"
+#include <cstdio>
+#include <cstring>
+
+static int failures = 0;
+
+std::vector<HostTest>& host_tests(void) {
+    static std::vector<HostTest> tests;
+    return tests;
+}
+
+void host_test_fail(const char* file, int line, const std::string& message) {
+    printf("    %s:%d: %s\n", file, line, message.c_str());
+    failures++;
+}
+
+static bool selected(const HostTest& test, int argc, char** argv) {
+    if (argc < 2)
+        return true;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], test.suite) == 0)
+            return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    int run = 0;
+    int failed = 0;
+    for (const HostTest& test : host_tests()) {
+        if (!selected(test, argc, argv))
+            continue;
+        int before = failures;
+        test.run();
+        run++;
+        bool ok = failures == before;
+        if (!ok)
+            failed++;
+        printf("%-6s %s.%s\n", ok ? "ok" : "FAIL", test.suite, test.name);
+    }
+    printf("\n%d tests, %d failed\n", run, failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * @brief ButtonFsm against simulated edge timings
+ *
+ * The driver below mirrors Button.cpp: every raw edge restarts a one-shot
+ * timer at the debounce time, the timer callback runs tick() and re-arms
+ * itself at getDeadline(). Edge lists include the contact bounce of a
+ * mechanical switch.
+ */
+#include "host_test.h"
+#include "board/ButtonFsm.h"
+
+typedef ButtonEvent::Type Type;
+
+struct Edge {
+    uint32_t at;
+    bool pressed;
+};
+
+struct TimedEvent {
+    uint32_t at;
+    ButtonEvent event;
+};
+
+/**
+ * @brief Runs the edges through the FSM like the button timer, up to end_ms
+ */
+static std::vector<TimedEvent> simulate(ButtonFsm& fsm, const std::vector<Edge>& edges, uint32_t end_ms,
+                                        uint32_t start_ms = 0) {
+    std::vector<TimedEvent> events;
+    ButtonFsm::Config config;
+    bool armed = false;
+    uint32_t timer_at = 0;
+    size_t next_edge = 0;
+
+    for (uint32_t now = start_ms; now != end_ms; now++) {
+        while (next_edge < edges.size() && edges[next_edge].at == now) {
+            fsm.edge(now, edges[next_edge].pressed);
+            timer_at = now + config.debounce_ms;
+            armed = true;
+            next_edge++;
+        }
+        if (armed && timer_at == now) {
+            armed = false;
+            ButtonFsm::Events out;
+            fsm.tick(now, out);
+            for (uint8_t i = 0; i < out.count; i++)
+                events.push_back({now, out.items[i]});
+
+            uint32_t deadline;
+            if (fsm.getDeadline(deadline)) {
+                int32_t delay = (int32_t)(deadline - now);
+                timer_at = now + (delay > 0 ? delay : 1);
+                armed = true;
+            }
+        }
+    }
+    return events;
+}
+
+// Press at `at` for held_ms, with bounce on both contacts
+static void click(std::vector<Edge>& edges, uint32_t at, uint32_t held_ms) {
+    edges.insert(edges.end(), {{at, true}, {at + 2, false}, {at + 3, true}, {at + 6, false}, {at + 8, true}});
+    uint32_t up = at + held_ms;
+    edges.insert(edges.end(), {{up, false}, {up + 1, true}, {up + 4, false}});
+}
+
+static std::vector<Type> types(const std::vector<TimedEvent>& events) {
+    std::vector<Type> out;
+    for (const TimedEvent& event : events)
+        out.push_back(event.event.type);
+    return out;
+}
+
+static int count(const std::vector<TimedEvent>& events, Type type) {
+    int n = 0;
+    for (const TimedEvent& event : events)
+        n += event.event.type == type;
+    return n;
+}
+
+TEST(ButtonFsm, BouncyClick) {
+    ButtonFsm fsm;
+    std::vector<Edge> edges;
+    click(edges, 100, 120);
+    auto events = simulate(fsm, edges, 2000);
+
+    CHECK(types(events) == std::vector<Type>({Type::PRESS, Type::RELEASE, Type::CLICK}));
+    if (events.size() == 3) {
+        CHECK_EQ(events[0].at, 128u);       // 20 ms after the last press bounce
+        CHECK_EQ(events[1].at, 244u);       // 20 ms after the last release bounce
+        CHECK_EQ(events[1].event.held_ms, 116u);
+        CHECK_EQ(events[2].at, 544u);       // Click gap after the release
+        CHECK_EQ(events[2].event.clicks, 1);
+    }
+    CHECK(!fsm.isPressed());
+}
+
+TEST(ButtonFsm, GlitchIsIgnored) {
+    ButtonFsm fsm;
+    auto events = simulate(fsm, {{100, true}, {105, false}, {300, true}, {312, false}}, 1000);
+    CHECK(events.empty());
+    uint32_t deadline;
+    CHECK(!fsm.getDeadline(deadline));
+}
+
+TEST(ButtonFsm, DoubleClick) {
+    ButtonFsm fsm;
+    std::vector<Edge> edges;
+    click(edges, 100, 80);
+    click(edges, 380, 80);      // 180 ms after the first release settles
+    auto events = simulate(fsm, edges, 2000);
+
+    CHECK_EQ(count(events, Type::PRESS), 2);
+    CHECK_EQ(count(events, Type::RELEASE), 2);
+    CHECK_EQ(count(events, Type::CLICK), 1);
+    if (!events.empty()) {
+        CHECK_EQ(events.back().event.type, Type::CLICK);
+        CHECK_EQ(events.back().event.clicks, 2);
+    }
+}
+
+TEST(ButtonFsm, GapSplitsSequences) {
+    ButtonFsm fsm;
+    std::vector<Edge> edges;
+    click(edges, 100, 80);
+    click(edges, 600, 80);      // Over 300 ms after the release
+    auto events = simulate(fsm, edges, 2000);
+
+    CHECK_EQ(count(events, Type::CLICK), 2);
+    for (const TimedEvent& event : events) {
+        if (event.event.type == Type::CLICK)
+            CHECK_EQ(event.event.clicks, 1);
+    }
+}
+
+TEST(ButtonFsm, MaxClicksEndsSequence) {
+    ButtonFsm fsm;
+    std::vector<Edge> edges;
+    for (int i = 0; i < 12; i++)
+        click(edges, 100 + i * 150, 60);
+    auto events = simulate(fsm, edges, 4000);
+
+    // The 10th release reports right away, the last two start a new sequence
+    std::vector<uint8_t> clicks;
+    uint32_t tenth_release = 0;
+    int releases = 0;
+    for (const TimedEvent& event : events) {
+        if (event.event.type == Type::RELEASE && ++releases == 10)
+            tenth_release = event.at;
+        if (event.event.type == Type::CLICK) {
+            clicks.push_back(event.event.clicks);
+            if (clicks.size() == 1)
+                CHECK_EQ(event.at, tenth_release);
+        }
+    }
+    CHECK(clicks == std::vector<uint8_t>({10, 2}));
+}
+
+TEST(ButtonFsm, LongPressAndHold) {
+    ButtonFsm fsm;
+    std::vector<Edge> edges;
+    click(edges, 100, 3500);
+    auto events = simulate(fsm, edges, 5000);
+
+    CHECK(types(events) == std::vector<Type>({Type::PRESS, Type::LONG_PRESS, Type::HOLD, Type::HOLD,
+                                              Type::RELEASE, Type::LONG_RELEASE}));
+    if (events.size() == 6) {
+        CHECK_EQ(events[1].at, 1128u);
+        CHECK_EQ(events[1].event.held_ms, 1000u);
+        CHECK_EQ(events[2].event.held_ms, 2000u);
+        CHECK_EQ(events[3].event.held_ms, 3000u);
+        CHECK_EQ(events[5].event.held_ms, 3496u);
+    }
+}
+
+TEST(ButtonFsm, LongPressEndsClickSequence) {
+    ButtonFsm fsm;
+    std::vector<Edge> edges;
+    click(edges, 100, 80);
+    click(edges, 300, 1500);
+    auto events = simulate(fsm, edges, 3000);
+
+    CHECK_EQ(count(events, Type::CLICK), 0);
+    CHECK_EQ(count(events, Type::LONG_PRESS), 1);
+    CHECK_EQ(count(events, Type::LONG_RELEASE), 1);
+}
+
+TEST(ButtonFsm, Deadlines) {
+    ButtonFsm fsm;
+    ButtonFsm::Events out;
+    uint32_t deadline = 0;
+    CHECK(!fsm.getDeadline(deadline));
+
+    fsm.edge(100, true);
+    CHECK(fsm.getDeadline(deadline));
+    CHECK_EQ(deadline, 120u);
+
+    fsm.tick(120, out);
+    CHECK(fsm.isPressed());
+    CHECK(fsm.getDeadline(deadline));
+    CHECK_EQ(deadline, 1120u);              // Long press
+
+    fsm.edge(200, false);
+    CHECK(fsm.getDeadline(deadline));
+    CHECK_EQ(deadline, 220u);
+
+    fsm.tick(220, out);
+    CHECK(fsm.getDeadline(deadline));
+    CHECK_EQ(deadline, 520u);               // Click gap
+
+    fsm.tick(520, out);
+    CHECK(!fsm.getDeadline(deadline));
+    CHECK_EQ(out.count, 3);
+    CHECK_EQ(out.items[0].type, Type::PRESS);
+    CHECK_EQ(out.items[1].type, Type::RELEASE);
+    CHECK_EQ(out.items[2].type, Type::CLICK);
+}
+
+TEST(ButtonFsm, TickWrap) {
+    // pdTICKS_TO_MS wraps after 49.7 days - a double click across the wrap
+    ButtonFsm fsm;
+    uint32_t start = 0xFFFFFFFFu - 150;
+    std::vector<Edge> edges;
+    click(edges, start + 50, 80);
+    click(edges, start + 250, 80);
+    auto events = simulate(fsm, edges, 2000, start);
+
+    CHECK_EQ(count(events, Type::CLICK), 1);
+    if (!events.empty())
+        CHECK_EQ(events.back().event.clicks, 2);
+}
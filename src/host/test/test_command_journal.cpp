@@ -0,0 +1,156 @@
+/**
+ * @brief CommandJournal compaction, replay filters, overflow and ageing
+ */
+#include "host_test.h"
+#include "volumio/CommandJournal.h"
+
+static VolumioCommand command(VolumioCommandType type, int value = 0, uint32_t trace_id = 0) {
+    VolumioCommand cmd = {type, value};
+    cmd.trace_id = trace_id;
+    return cmd;
+}
+
+static std::vector<CommandJournal::Entry> replay(CommandJournal& journal, uint32_t now_ms, const std::string& status) {
+    std::vector<CommandJournal::Entry> out;
+    journal.replay(now_ms, status, out);
+    return out;
+}
+
+TEST(CommandJournal, ToggleResolvedAgainstStatus) {
+    CommandJournal journal;
+    CHECK(journal.add(command(VolumioCommandType::TOGGLE), 0, "play"));
+    auto out = replay(journal, 0, "play");
+    // Already playing would dedup a PLAY - a resolved PAUSE goes out
+    CHECK_EQ(out.size(), (size_t)1);
+    CHECK_EQ(out[0].cmd.type, VolumioCommandType::PAUSE);
+
+    CHECK(journal.add(command(VolumioCommandType::TOGGLE), 0, "stop"));
+    out = replay(journal, 0, "play");
+    CHECK_EQ(out.size(), (size_t)0);
+    CHECK_EQ(journal.getStats().deduped, 1u);
+}
+
+TEST(CommandJournal, LastPlayPauseWins) {
+    CommandJournal journal;
+    journal.add(command(VolumioCommandType::PLAY), 0, "pause");
+    journal.add(command(VolumioCommandType::NEXT), 0, "pause");
+    journal.add(command(VolumioCommandType::TOGGLE), 0, "play");
+    journal.add(command(VolumioCommandType::PAUSE), 0, "play");
+    CHECK_EQ(journal.size(), (size_t)2);
+    CHECK_EQ(journal.getStats().journaled, 4u);
+    CHECK_EQ(journal.getStats().compacted, 2u);
+
+    auto out = replay(journal, 0, "play");
+    CHECK_EQ(out.size(), (size_t)2);
+    CHECK_EQ(out[0].cmd.type, VolumioCommandType::NEXT);
+    CHECK_EQ(out[1].cmd.type, VolumioCommandType::PAUSE);
+    CHECK(journal.empty());
+}
+
+TEST(CommandJournal, PairsCancel) {
+    CommandJournal journal;
+    journal.add(command(VolumioCommandType::RANDOM), 0, "play");
+    journal.add(command(VolumioCommandType::REPEAT), 0, "play");
+    journal.add(command(VolumioCommandType::RANDOM), 0, "play");
+    CHECK_EQ(journal.size(), (size_t)1);
+
+    // Status unknown - toggles cannot be resolved and cancel in pairs too
+    journal.add(command(VolumioCommandType::TOGGLE), 0, "");
+    journal.add(command(VolumioCommandType::TOGGLE), 0, "");
+    CHECK_EQ(journal.size(), (size_t)1);
+    CHECK_EQ(journal.getStats().compacted, 4u);
+
+    auto out = replay(journal, 0, "play");
+    CHECK_EQ(out.size(), (size_t)1);
+    CHECK_EQ(out[0].cmd.type, VolumioCommandType::REPEAT);
+}
+
+TEST(CommandJournal, LastSeekWinsTrackChangeDropsIt) {
+    CommandJournal journal;
+    journal.add(command(VolumioCommandType::SEEK, 10), 0, "play");
+    journal.add(command(VolumioCommandType::SEEK, 20), 0, "play");
+    CHECK_EQ(journal.size(), (size_t)1);
+
+    auto out = replay(journal, 0, "play");
+    CHECK_EQ(out.size(), (size_t)1);
+    CHECK_EQ(out[0].cmd.value, 20);
+
+    journal.add(command(VolumioCommandType::SEEK, 30), 0, "play");
+    journal.add(command(VolumioCommandType::PREV), 0, "play");
+    out = replay(journal, 0, "play");
+    CHECK_EQ(out.size(), (size_t)1);
+    CHECK_EQ(out[0].cmd.type, VolumioCommandType::PREV);
+}
+
+TEST(CommandJournal, VolumeSummedAndClamped) {
+    CommandJournal journal;
+    for (int i = 0; i < JOURNAL_MAX_VOLUME + 3; i++)
+        journal.add(command(VolumioCommandType::VOLUME, 5, 100 + i), i * 10, "play");
+    CHECK_EQ(journal.size(), (size_t)1);
+    CHECK_EQ(journal.getStats().compacted, (uint32_t)JOURNAL_MAX_VOLUME + 2);
+
+    // One step per command, the trace id stays with the first only
+    auto out = replay(journal, 1000, "play");
+    CHECK_EQ(out.size(), (size_t)JOURNAL_MAX_VOLUME);
+    for (size_t i = 0; i < out.size(); i++) {
+        CHECK_EQ(out[i].cmd.value, 1);
+        CHECK_EQ(out[i].cmd.trace_id, i == 0 ? 100u : 0u);
+        CHECK_EQ(out[i].time, (uint32_t)(JOURNAL_MAX_VOLUME + 2) * 10);
+    }
+    CHECK_EQ(journal.getStats().replayed, 1u);
+
+    // Steps that net out leave nothing
+    journal.add(command(VolumioCommandType::VOLUME, 1), 0, "play");
+    journal.add(command(VolumioCommandType::VOLUME, -1), 0, "play");
+    CHECK(journal.empty());
+}
+
+TEST(CommandJournal, ExpiresAfterMaxAge) {
+    CommandJournal journal;
+    journal.add(command(VolumioCommandType::NEXT), 1000, "play");
+    journal.add(command(VolumioCommandType::PREV), 2000, "play");
+
+    auto out = replay(journal, 2000 + JOURNAL_MAX_AGE, "play");
+    CHECK_EQ(out.size(), (size_t)1);
+    CHECK_EQ(out[0].cmd.type, VolumioCommandType::PREV);
+    CHECK_EQ(journal.getStats().expired, 1u);
+    CHECK_EQ(journal.getStats().replayed, 1u);
+}
+
+TEST(CommandJournal, OverflowDropsOldest) {
+    CommandJournal journal;
+    for (uint32_t i = 0; i < JOURNAL_SIZE + 2; i++)
+        journal.add(command(VolumioCommandType::NEXT, 0, i + 1), i, "play");
+    CHECK_EQ(journal.size(), (size_t)JOURNAL_SIZE);
+    CHECK_EQ(journal.getStats().overflows, 2u);
+
+    auto out = replay(journal, JOURNAL_SIZE + 2, "play");
+    CHECK_EQ(out.size(), (size_t)JOURNAL_SIZE);
+    CHECK_EQ(out.front().cmd.trace_id, 3u);
+    CHECK_EQ(out.back().cmd.trace_id, (uint32_t)JOURNAL_SIZE + 2);
+}
+
+TEST(CommandJournal, FailedReplayKeepsOriginalTime) {
+    CommandJournal journal;
+    journal.add(command(VolumioCommandType::NEXT), 1000, "play");
+
+    // Reachable for a moment, the send fails and the command goes back in
+    auto out = replay(journal, 20000, "play");
+    CHECK_EQ(out.size(), (size_t)1);
+    CHECK_EQ(out[0].time, 1000u);
+    journal.add(out[0].cmd, out[0].time, "play");
+
+    // Still counted from the original press, not from the failed replay
+    out = replay(journal, 1000 + JOURNAL_MAX_AGE + 1, "play");
+    CHECK_EQ(out.size(), (size_t)0);
+    CHECK_EQ(journal.getStats().expired, 1u);
+}
+
+TEST(CommandJournal, LocalCommandsRejected) {
+    CommandJournal journal;
+    CHECK(!journal.add(command(VolumioCommandType::SELECT_PLAYER, 1), 0, "play"));
+    CHECK(!journal.add(command(VolumioCommandType::TOGGLE_WIFI_MODE), 0, "play"));
+    CHECK(!journal.add(command(VolumioCommandType::POLL_PERIOD, 5000), 0, "play"));
+    CHECK(journal.empty());
+    CHECK_EQ(journal.getStats().journaled, 0u);
+}
@@ -0,0 +1,83 @@
+/**
+ * @brief CommandQueue overflow and the latency traces of dropped commands
+ *
+ * CommandQueue and LatencyTracer are singletons - every test leaves the
+ * queue drained and completes the traces it opened.
+ */
+#include "host_test.h"
+#include "notify/CommandQueue.h"
+#include "notify/LatencyTracer.h"
+#include "notify/Metrics.h"
+#include <cstring>
+
+#define QUEUE_SIZE      20      // CommandQueue::QUEUE_SIZE
+
+static uint32_t dropped_commands(void) {
+    static char buffer[METRICS_BUFFER];
+    Metrics::getInstance().render(buffer, sizeof(buffer), 0);     // NUL terminated, truncated or not
+    const char* key = "queue_dropped_total{queue=\"command\"} ";
+    const char* found = strstr(buffer, key);
+    return found != nullptr ? (uint32_t)atoi(found + strlen(key)) : 0;
+}
+
+static size_t in_flight(void) {
+    std::string json = LatencyTracer::getInstance().toJson();
+    const char* key = "\"in_flight\":";
+    size_t pos = json.find(key);
+    return pos == std::string::npos ? (size_t)-1 : std::stoul(json.substr(pos + strlen(key)));
+}
+
+// Drain the queue, returns the last trace id
+static uint32_t drain(size_t& count) {
+    VolumioCommand cmd;
+    uint32_t last = 0;
+    count = 0;
+    while (CommandQueue::getInstance().getNextCommand(cmd)) {
+        last = cmd.trace_id;
+        count++;
+    }
+    return last;
+}
+
+// Every stage for the id - completes it and the older traces with it
+static void complete(uint32_t id) {
+    LatencyTracer& tracer = LatencyTracer::getInstance();
+    tracer.mark(id, TraceStage::DEQUEUED);
+    tracer.mark(id, TraceStage::ACKED);
+    tracer.mark(id, TraceStage::FETCHED);
+    tracer.mark(id, TraceStage::DISPLAYED);
+}
+
+TEST(CommandQueue, DroppedCommandLeavesNoTrace) {
+    CommandQueue& queue = CommandQueue::getInstance();
+    uint32_t dropped = dropped_commands();
+
+    // Fill the queue - the post that fails is the dropped command
+    size_t queued = 0;
+    while (queued <= QUEUE_SIZE && queue.postCommand({VolumioCommandType::NEXT, 0})) {
+        queued++;
+    }
+    CHECK_EQ(queued, (size_t)QUEUE_SIZE);
+    CHECK_EQ(dropped_commands(), dropped + 1);
+
+    size_t count = 0;
+    uint32_t last = drain(count);
+    CHECK_EQ(count, queued);
+    CHECK(last != 0);
+
+    // The dropped command's trace is newer than every queued one - only cancelling closes it
+    complete(last);
+    CHECK_EQ(in_flight(), (size_t)0);
+}
+
+TEST(CommandQueue, LocalCommandsNotTraced) {
+    CommandQueue& queue = CommandQueue::getInstance();
+    CHECK(queue.postCommand({VolumioCommandType::SELECT_PLAYER, -1}));
+    CHECK(queue.postCommand({VolumioCommandType::TOGGLE_WIFI_MODE, 0}));
+    CHECK(queue.postCommand({VolumioCommandType::POLL_PERIOD, 5000}));
+
+    size_t count = 0;
+    CHECK_EQ(drain(count), 0u);
+    CHECK_EQ(count, (size_t)3);
+    CHECK_EQ(in_flight(), (size_t)0);
+}
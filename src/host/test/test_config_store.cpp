@@ -0,0 +1,310 @@
+/**
+ * @brief ConfigStore on the host Preferences stand-in
+ *
+ * Every test starts from an NVS state of its own and a fresh ConfigStore
+ * instance, which loads it like a boot does.
+ */
+#include "host_test.h"
+#include "config/ConfigStore.h"
+#include "host_clock.h"
+#include <Preferences.h>
+#include "wifi_config.h"
+#include <cstring>
+#include <functional>
+
+static void nvs_put(const char* key, const std::string& value) {
+    Preferences preferences;
+    preferences.begin(CONFIG_NAMESPACE, false);
+    preferences.putString(key, value);
+    preferences.end();
+}
+
+static std::vector<uint8_t>& nvs_blob(void) {
+    return host_nvs().spaces[CONFIG_NAMESPACE]["config"];
+}
+
+static bool nvs_has(const char* key) {
+    auto& space = host_nvs().spaces[CONFIG_NAMESPACE];
+    return space.find(key) != space.end();
+}
+
+// Boot with the given NVS contents - writes are counted from here
+static ConfigStore& boot(void) {
+    ConfigStore::resetInstance();
+    host_nvs().writes = 0;
+    return ConfigStore::getInstance();
+}
+
+static void reset_nvs(void) {
+    ConfigStore::resetInstance();
+    host_nvs_clear();
+}
+
+static Config make(const char* ssid, const char* password, const char* volumio) {
+    Config config;
+    config.ssid     = ssid;
+    config.password = password;
+    config.volumio  = volumio;
+    return config;
+}
+
+TEST(ConfigStore, FirstBootDefaults) {
+    reset_nvs();
+    ConfigStore& store = boot();
+    Config config = store.get();
+    CHECK_EQ(config.ssid, std::string(STA_SSID));
+    CHECK_EQ(config.password, std::string(STA_PASS));
+    CHECK_EQ(config.volumio, std::string(VOLUMIO_IP));
+    CHECK(!store.getStats().migrated);
+
+    // Defaults are not written until something changes
+    host_clock_advance(CONFIG_WRITE_DELAY * 2);
+    store.tick(xTaskGetTickCount());
+    store.flush();
+    CHECK_EQ(host_nvs().writes, 0u);
+}
+
+TEST(ConfigStore, MigratesOldKeys) {
+    reset_nvs();
+    nvs_put("ssid", "old-net");
+    nvs_put("pass", "old-pass");
+    nvs_put("ip", "192.168.1.20 192.168.1.21");
+
+    ConfigStore& store = boot();
+    CHECK(store.get() == make("old-net", "old-pass", "192.168.1.20 192.168.1.21"));
+    CHECK(store.getStats().migrated);
+
+    // Written as a blob once the write delay passed, old keys removed
+    store.tick(xTaskGetTickCount() + CONFIG_WRITE_DELAY - 1);
+    CHECK_EQ(host_nvs().writes, 0u);
+    store.tick(xTaskGetTickCount() + CONFIG_WRITE_DELAY);
+    CHECK_EQ(host_nvs().writes, 1u);
+    CHECK(nvs_has("config"));
+    CHECK(!nvs_has("ssid"));
+    CHECK(!nvs_has("pass"));
+    CHECK(!nvs_has("ip"));
+    CHECK(!store.getStats().migrated);
+
+    // Next boot reads the blob
+    ConfigStore& next = boot();
+    CHECK(next.get() == make("old-net", "old-pass", "192.168.1.20 192.168.1.21"));
+    CHECK(!next.getStats().migrated);
+    next.flush();
+    CHECK_EQ(host_nvs().writes, 0u);
+}
+
+TEST(ConfigStore, DebouncedWrite) {
+    reset_nvs();
+    ConfigStore& store = boot();
+    int notified = 0;
+    std::string seen;
+    store.subscribe([&](const Config& config) {
+        notified++;
+        seen = ConfigStore::getInstance().get().volumio;    // get() from a subscriber must not deadlock
+        CHECK(config == ConfigStore::getInstance().get());
+    });
+
+    // Edits 1.5 s apart - each one restarts the write delay
+    for (int i = 0; i < 5; i++) {
+        CHECK(store.update(make("net", "pass", ("host-" + std::to_string(i)).c_str())));
+        host_clock_advance(1500);
+        store.tick(xTaskGetTickCount());
+    }
+    CHECK_EQ(host_nvs().writes, 0u);
+    CHECK_EQ(notified, 5);
+    CHECK_EQ(seen, std::string("host-4"));
+
+    CHECK(!store.update(make("net", "pass", "host-4")));    // No change - no update, no notification
+    CHECK_EQ(notified, 5);
+
+    host_clock_advance(CONFIG_WRITE_DELAY - 1500);
+    store.tick(xTaskGetTickCount());
+    CHECK_EQ(host_nvs().writes, 1u);
+    CHECK_EQ(store.getStats().updates, 5u);
+    CHECK_EQ(store.getStats().writes, 1u);
+
+    ConfigStore& next = boot();
+    CHECK_EQ(next.get().volumio, std::string("host-4"));
+}
+
+TEST(ConfigStore, SameCrcSkipped) {
+    reset_nvs();
+    ConfigStore& store = boot();
+    store.update(make("net", "pass", "a.local"));
+    store.flush();
+    CHECK_EQ(host_nvs().writes, 1u);
+
+    // Changed and changed back before the write
+    store.update(make("net", "pass", "b.local"));
+    store.update(make("net", "pass", "a.local"));
+    host_clock_advance(CONFIG_WRITE_DELAY);
+    store.tick(xTaskGetTickCount());
+    CHECK_EQ(host_nvs().writes, 1u);
+    CHECK_EQ(store.getStats().skipped, 1u);
+
+    // The CRC of a loaded blob counts too
+    ConfigStore& next = boot();
+    next.update(make("net", "pass", "c.local"));
+    next.update(make("net", "pass", "a.local"));
+    next.flush();
+    CHECK_EQ(host_nvs().writes, 0u);
+    CHECK_EQ(next.getStats().skipped, 1u);
+}
+
+TEST(ConfigStore, CorruptBlobRejected) {
+    reset_nvs();
+    ConfigStore& store = boot();
+    store.update(make("net", "secret", "a.local"));
+    store.flush();
+    std::vector<uint8_t> good = nvs_blob();
+
+    // Flipped payload byte - CRC mismatch, back to the defaults
+    nvs_blob()[good.size() - 1] ^= 0x01;
+    CHECK_EQ(boot().get().ssid, std::string(STA_SSID));
+
+    // Truncated, wrong magic
+    nvs_blob() = std::vector<uint8_t>(good.begin(), good.end() - 3);
+    CHECK_EQ(boot().get().ssid, std::string(STA_SSID));
+    nvs_blob() = good;
+    nvs_blob()[0] ^= 0xFF;
+    CHECK_EQ(boot().get().ssid, std::string(STA_SSID));
+
+    // Corrupt blob next to old keys - the old keys are used and migrated
+    nvs_put("ssid", "old-net");
+    ConfigStore& migrated = boot();
+    CHECK_EQ(migrated.get().ssid, std::string("old-net"));
+    CHECK(migrated.getStats().migrated);
+    migrated.flush();
+    CHECK(!nvs_has("ssid"));
+
+    nvs_blob() = good;
+    CHECK(boot().get() == make("net", "secret", "a.local"));
+}
+
+TEST(ConfigStore, FailedWriteRetried) {
+    reset_nvs();
+    ConfigStore& store = boot();
+    host_nvs().fail_writes = true;
+    store.update(make("net", "pass", "a.local"));
+    store.flush();
+    CHECK_EQ(store.getStats().writes, 0u);
+    CHECK(!nvs_has("config"));
+
+    host_nvs().fail_writes = false;
+    host_clock_advance(CONFIG_WRITE_DELAY);
+    store.tick(xTaskGetTickCount());
+    CHECK_EQ(store.getStats().writes, 1u);
+    CHECK(boot().get() == make("net", "pass", "a.local"));
+}
+
+TEST(ConfigStore, EncodeDecode) {
+    uint8_t blob[CONFIG_MAX_SIZE];
+    Config config = make("net", "", "192.168.1.20,192.168.1.21");
+    size_t len = ConfigStore::encode(config, blob, sizeof(blob));
+    CHECK(len > 0);
+
+    Config decoded;
+    CHECK(ConfigStore::decode(blob, len, decoded));
+    CHECK(decoded == config);
+    CHECK(!ConfigStore::decode(blob, len - 1, decoded));
+    CHECK(!ConfigStore::decode(blob, 4, decoded));
+
+    // Strings are length-prefixed with one byte, the blob is bounded
+    CHECK_EQ(ConfigStore::encode(make(std::string(256, 'x').c_str(), "", ""), blob, sizeof(blob)), 0u);
+    CHECK_EQ(ConfigStore::encode(config, blob, 16), 0u);
+
+    const uint8_t check[] = "123456789";
+    CHECK_EQ(ConfigStore::crc32(check, 9), 0xCBF43926u);     // CRC-32 check value
+}
+
+/**
+ * @brief Settings page session - the access pattern the NVS numbers are taken from
+ *
+ * Boot, open the page, save a new Volumio host, fix a typo in it 1 s later,
+ * save the unchanged form again after 30 s. The page reloads the settings
+ * after every save. The WiFi task ticks every 100 ms.
+ */
+struct ConfigSession {
+    std::function<void(void)> boot;
+    std::function<void(void)> get;
+    std::function<void(const Config&)> post;
+    std::function<void(void)> tick;
+
+    void wait(uint32_t ms) {
+        for (uint32_t t = 0; t < ms; t += 100) {
+            host_clock_advance(100);
+            tick();
+        }
+    }
+
+    void run(void) {
+        boot();
+        get();
+        post(make("net", "secret", "volumio.locl"));
+        get();
+        wait(1000);
+        post(make("net", "secret", "volumio.local"));
+        get();
+        wait(30000);
+        post(make("net", "secret", "volumio.local"));
+        get();
+        wait(30000);
+    }
+};
+
+static void reset_counters(void) {
+    host_nvs().opens = host_nvs().reads = host_nvs().writes = host_nvs().unchanged = 0;
+}
+
+TEST(ConfigStore, SessionNvsAccess) {
+    // Before: a Preferences session per boot, /get and /post, one key per field
+    reset_nvs();
+    nvs_put("ssid", "net");
+    nvs_put("pass", "secret");
+    nvs_put("ip", "192.168.1.20");
+    reset_counters();
+
+    auto legacy_get = [](std::initializer_list<const char*> keys) {
+        Preferences preferences;
+        preferences.begin(CONFIG_NAMESPACE, false);
+        for (const char* key : keys)
+            preferences.getString(key, "");
+        preferences.end();
+    };
+    ConfigSession legacy;
+    legacy.boot = [&] { legacy_get({"ssid", "pass", "ip"}); };      // WiFiHandler constructor
+    legacy.get  = [&] { legacy_get({"ssid", "ip"}); };              // /get
+    legacy.post = [](const Config& config) {                        // /post
+        Preferences preferences;
+        preferences.begin(CONFIG_NAMESPACE, false);
+        preferences.putString("ssid", config.ssid);
+        preferences.putString("pass", config.password);
+        preferences.putString("ip", config.volumio);
+        preferences.end();
+    };
+    legacy.tick = [] { };
+    legacy.run();
+
+    CHECK_EQ(host_nvs().opens, 8u);
+    CHECK_EQ(host_nvs().reads, 11u);
+    CHECK_EQ(host_nvs().writes, 9u);
+    CHECK_EQ(host_nvs().writes - host_nvs().unchanged, 2u);    // Values that changed
+
+    // After: one blob, read at boot, written once the edits settled
+    reset_nvs();
+    boot().update(make("net", "secret", "192.168.1.20"));
+    ConfigStore::getInstance().flush();
+    reset_counters();
+
+    ConfigSession store;
+    store.boot = [] { boot(); };
+    store.get  = [] { ConfigStore::getInstance().get(); };
+    store.post = [](const Config& config) { ConfigStore::getInstance().update(config); };
+    store.tick = [] { ConfigStore::getInstance().tick(xTaskGetTickCount()); };
+    store.run();
+
+    CHECK_EQ(host_nvs().opens, 2u);
+    CHECK_EQ(host_nvs().reads, 2u);
+    CHECK_EQ(host_nvs().writes, 1u);
+    CHECK_EQ(host_nvs().writes - host_nvs().unchanged, 1u);
+}
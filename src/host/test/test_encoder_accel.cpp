@@ -0,0 +1,164 @@
+/**
+ * @brief EncoderAccel against replayed detent timings
+ *
+ * Timings are (interval, direction) runs as the PCNT callback would stamp
+ * them. The default Config equals the device's ENCODER_* settings.
+ */
+#include "host_test.h"
+#include "board/EncoderAccel.h"
+
+#define START_US    1000000
+
+/**
+ * @brief Feeds count detents spaced interval_us apart, continuing at *time_us
+ */
+static void turn(EncoderAccel& accel, uint32_t* time_us, uint32_t interval_us, int count,
+                 int8_t direction, EncoderBatch& batch) {
+    for (int i = 0; i < count; i++) {
+        *time_us += interval_us;
+        accel.feed(*time_us, direction, batch);
+    }
+}
+
+TEST(EncoderAccel, SlowTurnIsOneToOne) {
+    EncoderAccel accel;
+    EncoderBatch batch;
+    uint32_t time_us = START_US;
+    turn(accel, &time_us, 150000, 10, 1, batch);      // ~7 detents/s
+
+    CHECK_EQ(batch.steps, 10);
+    CHECK_EQ(batch.accelerated, 10);
+    CHECK_EQ(batch.count, 10);
+    CHECK_EQ(batch.glitches, 0);
+    CHECK_EQ(batch.first_us, (uint32_t)START_US + 150000);
+    CHECK_EQ(batch.last_us, time_us);
+    CHECK(batch.velocity < 10);
+}
+
+TEST(EncoderAccel, FastSpinReachesMaxFactor) {
+    EncoderAccel accel;
+    EncoderBatch batch;
+    uint32_t time_us = START_US;
+    turn(accel, &time_us, 10000, 40, -1, batch);      // 100 detents/s
+
+    CHECK_EQ(batch.steps, -40);
+    CHECK(batch.velocity >= 95 && batch.velocity <= 100);
+    // The velocity passes max_speed after a few detents, the rest count 8x
+    CHECK(batch.accelerated <= -8 * 35);
+    CHECK(batch.accelerated >= -8 * 40);
+
+    // Steady spin in the next poll - exactly max_factor per detent
+    EncoderBatch next;
+    turn(accel, &time_us, 10000, 10, -1, next);
+    CHECK_EQ(next.accelerated, -80);
+}
+
+TEST(EncoderAccel, CurveIsMonotonic) {
+    const uint32_t intervals[] = {150000, 60000, 30000, 20000, 10000, 5000};
+    int32_t previous = 0;
+    for (uint32_t interval : intervals) {
+        EncoderAccel accel;
+        EncoderBatch batch;
+        uint32_t time_us = START_US;
+        turn(accel, &time_us, interval, 30, 1, batch);
+        CHECK_EQ(batch.steps, 30);
+        CHECK(batch.accelerated >= previous);
+        previous = batch.accelerated;
+    }
+    CHECK(previous <= 8 * 30);
+}
+
+TEST(EncoderAccel, FractionCarriesOver) {
+    // max_factor 2 at 35 detents/s gives 1.5 steps per detent
+    EncoderAccel::Config config;
+    config.max_factor = 2;
+    EncoderAccel accel(config);
+    uint32_t time_us = START_US;
+
+    EncoderBatch warmup;
+    turn(accel, &time_us, 27777, 20, 1, warmup);       // Instant speed 36, smoothed to 35
+    CHECK_EQ(warmup.velocity, 35u);
+
+    EncoderBatch batch;
+    turn(accel, &time_us, 27777, 20, 1, batch);
+    CHECK_EQ(batch.accelerated, 30);
+}
+
+TEST(EncoderAccel, BounceIsRejected) {
+    EncoderAccel accel;
+    EncoderBatch batch;
+    uint32_t time_us = START_US;
+    turn(accel, &time_us, 100000, 3, 1, batch);
+
+    // Contact bounce on the third detent: a reversal and the step back 400 us apart
+    accel.feed(time_us + 400, -1, batch);
+    accel.feed(time_us + 800, 1, batch);
+    time_us += 800;
+    turn(accel, &time_us, 100000, 2, 1, batch);
+
+    CHECK_EQ(batch.steps, 5);
+    CHECK_EQ(batch.accelerated, 5);
+    CHECK_EQ(batch.glitches, 2);
+    CHECK_EQ(batch.count, 5);
+}
+
+TEST(EncoderAccel, SlowReversalIsKept) {
+    EncoderAccel accel;
+    EncoderBatch batch;
+    uint32_t time_us = START_US;
+    turn(accel, &time_us, 10000, 10, 1, batch);
+    CHECK(accel.getVelocity() > 60);
+
+    // Reversal after 50 ms is a real turn back - counted, velocity restarts
+    turn(accel, &time_us, 50000, 1, -1, batch);
+    CHECK_EQ(batch.steps, 9);
+    CHECK_EQ(batch.glitches, 0);
+    CHECK_EQ(accel.getVelocity(), 0u);
+
+    EncoderBatch back;
+    turn(accel, &time_us, 100000, 3, -1, back);
+    CHECK_EQ(back.accelerated, -3);
+}
+
+TEST(EncoderAccel, PauseResetsVelocity) {
+    EncoderAccel accel;
+    EncoderBatch spin;
+    uint32_t time_us = START_US;
+    turn(accel, &time_us, 10000, 20, 1, spin);
+
+    // Same direction after a pause longer than timeout_us - starts at 1:1
+    EncoderBatch batch;
+    turn(accel, &time_us, 250000, 1, 1, batch);
+    CHECK_EQ(batch.accelerated, 1);
+    CHECK_EQ(batch.velocity, 0u);
+}
+
+TEST(EncoderAccel, TimestampWrap) {
+    // The microsecond counter wraps every 71 minutes - only differences count
+    EncoderAccel plain;
+    EncoderAccel wrapped;
+    EncoderBatch a;
+    EncoderBatch b;
+    uint32_t time_a = START_US;
+    uint32_t time_b = 0xFFFFFFFFu - 100000;
+    turn(plain, &time_a, 15000, 30, 1, a);
+    turn(wrapped, &time_b, 15000, 30, 1, b);
+
+    CHECK_EQ(b.steps, a.steps);
+    CHECK_EQ(b.accelerated, a.accelerated);
+    CHECK_EQ(b.velocity, a.velocity);
+    CHECK_EQ(b.glitches, 0);
+}
+
+TEST(EncoderAccel, ResetForgetsHistory) {
+    EncoderAccel accel;
+    EncoderBatch batch;
+    uint32_t time_us = START_US;
+    turn(accel, &time_us, 10000, 20, 1, batch);
+    accel.reset();
+    CHECK_EQ(accel.getVelocity(), 0u);
+
+    EncoderBatch next;
+    turn(accel, &time_us, 10000, 1, 1, next);
+    CHECK_EQ(next.accelerated, 1);
+}
@@ -0,0 +1,246 @@
+/**
+ * @brief EventStream fan-out to dozens of simulated SSE clients
+ *
+ * Runs on the ESPAsyncWebServer stand-in in src/host/include: clients are
+ * connected, drained and dropped by the test, each with the library's
+ * SSE_MAX_QUEUED_MESSAGES backlog cap. EventStream is a singleton, so every
+ * test publishes values of its own and disconnects its clients at the end.
+ */
+#include "host_test.h"
+#include "webserver/EventStream.h"
+#include "notify/Metrics.h"
+#include <cstring>
+
+#define LOAD_CLIENTS    48
+#define QUEUE_SIZE      8       // EventStream::QUEUE_SIZE
+
+static AsyncEventSource& source(void) {
+    static AsyncWebServer server(80);
+    static AsyncEventSource* events = nullptr;
+    if (events == nullptr) {
+        EventStream::getInstance().attach(server);
+        events = static_cast<AsyncEventSource*>(server.handlers.back());
+    }
+    return *events;
+}
+
+// Connected clients of one test, dropped when it ends
+struct Clients {
+    std::vector<AsyncEventSourceClient*> list;
+
+    AsyncEventSourceClient* connect(void) {
+        list.push_back(source().connect());
+        return list.back();
+    }
+    void connect(int count) {
+        for (int i = 0; i < count; i++)
+            connect();
+    }
+    ~Clients() {
+        for (AsyncEventSourceClient* client : list)
+            source().disconnect(client);
+    }
+};
+
+// Battery levels no earlier test has published
+static int fresh_level(void) {
+    static int level = 1000;
+    return level++;
+}
+
+static uint32_t dropped_frames(void) {
+    static char buffer[METRICS_BUFFER];
+    Metrics::getInstance().render(buffer, sizeof(buffer), 0);     // NUL terminated, truncated or not
+    const char* key = "queue_dropped_total{queue=\"event_stream\"} ";
+    const char* found = strstr(buffer, key);
+    return found != nullptr ? (uint32_t)atoi(found + strlen(key)) : 0;
+}
+
+TEST(EventStream, FanOut) {
+    Clients clients;
+    EventStream& stream = EventStream::getInstance();
+    CHECK_EQ(source().getUrl(), std::string("/events"));
+    // Replay of earlier tests' frames is not part of this one
+    clients.connect(LOAD_CLIENTS);
+    for (AsyncEventSourceClient* client : clients.list)
+        client->drain();
+    CHECK_EQ(stream.getClientCount(), (size_t)LOAD_CLIENTS);
+
+    int first = fresh_level();
+    for (int i = 1; i < 5; i++)
+        fresh_level();
+    for (int i = 0; i < 5; i++)
+        CHECK(stream.publishBattery(first + i));
+    stream.process();
+
+    for (AsyncEventSourceClient* client : clients.list) {
+        auto sent = client->drain();
+        CHECK_EQ(sent.size(), 5u);
+        for (size_t i = 0; i < sent.size(); i++) {
+            CHECK_EQ(sent[i].event, std::string("battery"));
+            CHECK_EQ(sent[i].data, "{\"level\":" + std::to_string(first + (int)i) + "}");
+            if (i > 0)
+                CHECK(sent[i].id > sent[i - 1].id);
+        }
+        CHECK_EQ(client->dropped, 0u);
+    }
+}
+
+TEST(EventStream, Deduplicates) {
+    Clients clients;
+    EventStream& stream = EventStream::getInstance();
+    AsyncEventSourceClient* client = clients.connect();
+    client->drain();
+
+    int level = fresh_level();
+    Info info;
+    info.status = "play";
+    info.title  = "Dedup " + std::to_string(level);
+    info.seek   = 1000;
+
+    stream.publishBattery(level);
+    stream.publishBattery(level);
+    stream.publishState(info);
+    stream.publishState(info);
+    stream.process();
+    stream.publishState(info);          // Same as the last state of a previous pass
+    stream.process();
+
+    auto sent = client->drain();
+    CHECK_EQ(sent.size(), 2u);
+
+    info.seek = 2000;                   // Any change goes out
+    stream.publishState(info);
+    stream.process();
+    sent = client->drain();
+    CHECK_EQ(sent.size(), 1u);
+    if (!sent.empty())
+        CHECK_EQ(sent[0].event, std::string("state"));
+}
+
+TEST(EventStream, ReplayOnConnect) {
+    Clients clients;
+    EventStream& stream = EventStream::getInstance();
+    int level = fresh_level();
+    Info info;
+    info.status = "pause";
+    info.title  = "Replay " + std::to_string(level);
+    stream.publishState(info);
+    stream.publishPopup("Volume", std::to_string(level).c_str());
+    stream.publishBattery(level);
+    stream.process();
+
+    // Every late joiner sees the current view, one frame per topic
+    for (int i = 0; i < LOAD_CLIENTS; i++) {
+        AsyncEventSourceClient* client = clients.connect();
+        auto sent = client->drain();
+        CHECK_EQ(sent.size(), 3u);
+        if (sent.size() == 3) {
+            CHECK_EQ(sent[0].event, std::string("state"));
+            CHECK_EQ(sent[1].event, std::string("popup"));
+            CHECK_EQ(sent[2].event, std::string("battery"));
+            CHECK_EQ(sent[2].data, "{\"level\":" + std::to_string(level) + "}");
+            CHECK_EQ(sent[0].reconnect, (uint32_t)EVENT_STREAM_RETRY);
+        }
+    }
+}
+
+TEST(EventStream, PublishQueueIsBounded) {
+    Clients clients;
+    EventStream& stream = EventStream::getInstance();
+    AsyncEventSourceClient* client = clients.connect();
+    client->drain();
+
+    // Producers outrun the WiFi task - the queue keeps QUEUE_SIZE frames, the rest is counted
+    uint32_t dropped = dropped_frames();
+    int accepted = 0;
+    for (int i = 0; i < QUEUE_SIZE + 4; i++)
+        accepted += stream.publishBattery(fresh_level()) ? 1 : 0;
+    CHECK_EQ(accepted, QUEUE_SIZE);
+    CHECK_EQ(dropped_frames(), dropped + 4);
+
+    stream.process();
+    CHECK_EQ(client->drain().size(), (size_t)QUEUE_SIZE);
+}
+
+TEST(EventStream, SlowClientsLoseFrames) {
+    Clients clients;
+    EventStream& stream = EventStream::getInstance();
+    clients.connect(LOAD_CLIENTS);
+    for (AsyncEventSourceClient* client : clients.list)
+        client->drain();
+
+    // Every sixth client never reads - its backlog stops at SSE_MAX_QUEUED_MESSAGES
+    const int rounds = SSE_MAX_QUEUED_MESSAGES + 12;
+    size_t fast_received = 0;
+    for (int round = 0; round < rounds; round++) {
+        stream.publishBattery(fresh_level());
+        stream.process();
+        for (size_t i = 0; i < clients.list.size(); i++) {
+            if (i % 6 != 0)
+                fast_received += clients.list[i]->drain().size();
+        }
+    }
+
+    CHECK_EQ(fast_received, (size_t)rounds * (LOAD_CLIENTS - LOAD_CLIENTS / 6));
+    for (size_t i = 0; i < clients.list.size(); i++) {
+        AsyncEventSourceClient* client = clients.list[i];
+        if (i % 6 == 0) {
+            CHECK_EQ(client->backlog.size(), (size_t)SSE_MAX_QUEUED_MESSAGES);
+            CHECK_EQ(client->dropped, (uint32_t)(rounds - SSE_MAX_QUEUED_MESSAGES));
+        }
+        else {
+            CHECK_EQ(client->dropped, 0u);
+        }
+    }
+}
+
+TEST(EventStream, ClientChurn) {
+    // Clients come and go between passes - each sees the replay, then every later frame in order
+    Clients clients;
+    EventStream& stream = EventStream::getInstance();
+    struct Seen {
+        AsyncEventSourceClient* client;
+        uint32_t last_id;
+        uint32_t frames;
+    };
+    std::vector<Seen> seen;
+    uint32_t out_of_order = 0;
+
+    for (int round = 0; round < 200; round++) {
+        if (round % 3 == 0 && seen.size() < LOAD_CLIENTS) {
+            AsyncEventSourceClient* client = clients.connect();
+            seen.push_back({client, 0, 0});
+        }
+        if (round % 7 == 0 && seen.size() > 4) {
+            source().disconnect(seen.front().client);
+            clients.list.erase(std::find(clients.list.begin(), clients.list.end(), seen.front().client));
+            seen.erase(seen.begin());
+        }
+
+        stream.publishBattery(fresh_level());
+        if (round % 5 == 0) {
+            Info info;
+            info.title = "Churn " + std::to_string(round);
+            stream.publishState(info);
+        }
+        stream.process();
+
+        for (Seen& entry : seen) {
+            for (const HostSseMessage& message : entry.client->drain()) {
+                // Replayed frames repeat the current id, live frames strictly increase
+                if (entry.frames > 0 && message.id < entry.last_id)
+                    out_of_order++;
+                entry.last_id = message.id;
+                entry.frames++;
+            }
+        }
+    }
+
+    CHECK_EQ(out_of_order, 0u);
+    CHECK(source().count() >= 20);
+    for (const Seen& entry : seen) {
+        CHECK(entry.frames > 0);
+        CHECK_EQ(entry.client->dropped, 0u);
+    }
+}
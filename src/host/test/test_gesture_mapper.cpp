@@ -0,0 +1,312 @@
+/**
+ * @brief GestureMapper and TouchFilter against FT3267 register dumps
+ *
+ * Each dump is the 6-byte burst the driver reads from register 0x01: gesture
+ * id, TD_STATUS (point count), first point XH (event flag in bits 7..6), XL,
+ * YH, YL. Sequences follow a touch frame by frame at the controller's report
+ * rate: press down, contact frames while the gesture id builds up, lift up,
+ * then the idle frame.
+ */
+#include "host_test.h"
+#include "board/GestureMapper.h"
+#include "board/TouchFilter.h"
+
+typedef uint8_t Dump[GestureMapper::DUMP_SIZE];
+
+#define EV_DOWN     0x00
+#define EV_UP       0x40
+#define EV_CONTACT  0x80
+
+static const Dump swipe_left[] = {
+    {0x00, 0x01, EV_DOWN    | 0x00, 0xB4, 0x00, 0x78},
+    {0x00, 0x01, EV_CONTACT | 0x00, 0xA0, 0x00, 0x79},
+    {0x00, 0x01, EV_CONTACT | 0x00, 0x82, 0x00, 0x79},
+    {0x14, 0x01, EV_CONTACT | 0x00, 0x5F, 0x00, 0x7A},
+    {0x14, 0x01, EV_CONTACT | 0x00, 0x3C, 0x00, 0x7A},
+    {0x14, 0x01, EV_UP      | 0x00, 0x28, 0x00, 0x7B},
+    {0x14, 0x00, EV_UP      | 0x00, 0x28, 0x00, 0x7B},  // Id is kept until the idle frame
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+static const Dump swipe_right[] = {
+    {0x00, 0x01, EV_DOWN    | 0x00, 0x28, 0x00, 0x80},
+    {0x00, 0x01, EV_CONTACT | 0x00, 0x50, 0x00, 0x80},
+    {0x1C, 0x01, EV_CONTACT | 0x00, 0x8C, 0x00, 0x81},
+    {0x1C, 0x01, EV_CONTACT | 0x00, 0xBE, 0x00, 0x81},
+    {0x1C, 0x00, EV_UP      | 0x00, 0xBE, 0x00, 0x81},
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+static const Dump swipe_up[] = {
+    {0x00, 0x01, EV_DOWN    | 0x00, 0x78, 0x00, 0xC8},
+    {0x10, 0x01, EV_CONTACT | 0x00, 0x78, 0x00, 0x8C},
+    {0x10, 0x01, EV_CONTACT | 0x00, 0x79, 0x00, 0x46},
+    {0x10, 0x00, EV_UP      | 0x00, 0x79, 0x00, 0x46},
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+static const Dump swipe_down[] = {
+    {0x00, 0x01, EV_DOWN    | 0x00, 0x78, 0x00, 0x32},
+    {0x18, 0x01, EV_CONTACT | 0x00, 0x77, 0x00, 0x6E},
+    {0x18, 0x01, EV_CONTACT | 0x00, 0x77, 0x00, 0xB4},
+    {0x18, 0x00, EV_UP      | 0x00, 0x77, 0x00, 0xB4},
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+// Plain tap - never reports a gesture id
+static const Dump tap[] = {
+    {0x00, 0x01, EV_DOWN    | 0x00, 0x78, 0x00, 0x78},
+    {0x00, 0x01, EV_CONTACT | 0x00, 0x78, 0x00, 0x78},
+    {0x00, 0x00, EV_UP      | 0x00, 0x78, 0x00, 0x78},
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+// Two-finger pinch - zoom ids have no command
+static const Dump zoom[] = {
+    {0x00, 0x02, EV_DOWN    | 0x00, 0x50, 0x00, 0x50},
+    {0x48, 0x02, EV_CONTACT | 0x00, 0x46, 0x00, 0x46},
+    {0x48, 0x02, EV_CONTACT | 0x00, 0x3C, 0x00, 0x3C},
+    {0x49, 0x02, EV_CONTACT | 0x00, 0x46, 0x00, 0x46},
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+// Swipe left that turns into a swipe down before lift - still one touch
+static const Dump swipe_turn[] = {
+    {0x00, 0x01, EV_DOWN    | 0x00, 0xB4, 0x00, 0x32},
+    {0x14, 0x01, EV_CONTACT | 0x00, 0x64, 0x00, 0x32},
+    {0x18, 0x01, EV_CONTACT | 0x00, 0x64, 0x00, 0x96},
+    {0x18, 0x00, EV_UP      | 0x00, 0x64, 0x00, 0x96},
+    {0x00, 0x00, 0xFF,              0xFF, 0xFF, 0xFF},
+};
+
+template <size_t N>
+static std::vector<VolumioCommand> replay(GestureMapper& mapper, const Dump (&dumps)[N]) {
+    std::vector<VolumioCommand> commands;
+    for (const Dump& dump : dumps) {
+        VolumioCommand cmd;
+        if (mapper.feed(dump, cmd))
+            commands.push_back(cmd);
+    }
+    return commands;
+}
+
+TEST(GestureMapper, SwipeLeftIsOneNext) {
+    GestureMapper mapper;
+    auto commands = replay(mapper, swipe_left);
+    CHECK_EQ(commands.size(), 1u);
+    if (commands.size() == 1)
+        CHECK_EQ(commands[0].type, VolumioCommandType::NEXT);
+    CHECK(!mapper.isConsumed());    // Idle frame re-armed it
+}
+
+TEST(GestureMapper, SwipeDirections) {
+    GestureMapper mapper;
+    auto right = replay(mapper, swipe_right);
+    auto up    = replay(mapper, swipe_up);
+    auto down  = replay(mapper, swipe_down);
+
+    CHECK_EQ(right.size(), 1u);
+    CHECK_EQ(up.size(), 1u);
+    CHECK_EQ(down.size(), 1u);
+    if (right.size() == 1)
+        CHECK_EQ(right[0].type, VolumioCommandType::PREV);
+    if (up.size() == 1) {
+        CHECK_EQ(up[0].type, VolumioCommandType::VOLUME);
+        CHECK_EQ(up[0].value, 1);
+    }
+    if (down.size() == 1) {
+        CHECK_EQ(down[0].type, VolumioCommandType::VOLUME);
+        CHECK_EQ(down[0].value, -1);
+    }
+}
+
+TEST(GestureMapper, TapAndZoomHaveNoCommand) {
+    GestureMapper mapper;
+    CHECK(replay(mapper, tap).empty());
+    CHECK(!mapper.isConsumed());
+    CHECK(replay(mapper, zoom).empty());
+    CHECK(!mapper.isConsumed());
+}
+
+TEST(GestureMapper, OneCommandPerTouch) {
+    GestureMapper mapper;
+    auto commands = replay(mapper, swipe_turn);
+    CHECK_EQ(commands.size(), 1u);
+    if (commands.size() == 1)
+        CHECK_EQ(commands[0].type, VolumioCommandType::NEXT);
+}
+
+TEST(GestureMapper, ConsumedUntilIdleFrame) {
+    GestureMapper mapper;
+    VolumioCommand cmd;
+    CHECK(!mapper.feed(swipe_left[0], cmd));
+    CHECK(mapper.feed(swipe_left[3], cmd));
+    CHECK(mapper.isConsumed());
+
+    // Lift frames still carry the id - no repeat, still consumed
+    CHECK(!mapper.feed(swipe_left[5], cmd));
+    CHECK(!mapper.feed(swipe_left[6], cmd));
+    CHECK(mapper.isConsumed());
+
+    CHECK(!mapper.feed(swipe_left[7], cmd));
+    CHECK(!mapper.isConsumed());
+    CHECK(mapper.feed(swipe_left[3], cmd));
+}
+
+TEST(GestureMapper, ReleaseRearms) {
+    // The driver reports the end of a touch without an idle frame when the
+    // interrupt line drops, BoardHandler calls release() then
+    GestureMapper mapper;
+    VolumioCommand cmd;
+    CHECK(mapper.feed(swipe_right[2], cmd));
+    CHECK(!mapper.feed(swipe_right[3], cmd));
+    mapper.release();
+    CHECK(!mapper.isConsumed());
+    CHECK(mapper.feed(swipe_right[3], cmd));
+    CHECK_EQ(cmd.type, VolumioCommandType::PREV);
+}
+
+TEST(GestureMapper, BackToBackSwipes) {
+    GestureMapper mapper;
+    std::vector<VolumioCommand> commands;
+    for (int i = 0; i < 5; i++) {
+        auto swipe = replay(mapper, swipe_up);
+        commands.insert(commands.end(), swipe.begin(), swipe.end());
+    }
+    CHECK_EQ(commands.size(), 5u);
+}
+
+TEST(GestureMapper, StatusHighNibbleIgnored) {
+    // TD_STATUS bits 7..4 are reserved - only the low nibble counts points
+    GestureMapper mapper;
+    VolumioCommand cmd;
+    const Dump fired = {0x14, 0x01, EV_CONTACT, 0x50, 0x00, 0x50};
+    const Dump idle  = {0x00, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF};
+    CHECK(mapper.feed(fired, cmd));
+    CHECK(!mapper.feed(idle, cmd));
+    CHECK(!mapper.isConsumed());
+}
+
+TEST(GestureMapper, NullDump) {
+    GestureMapper mapper;
+    VolumioCommand cmd;
+    CHECK(!mapper.feed(nullptr, cmd));
+}
+
+/**
+ * @brief What LVGL does with the reports of a pointer indev
+ *
+ * A press that ends in a release clicks the widget under it (an IconButton
+ * sends its command, the arc sends a seek). A cancelled press is dropped
+ * after the read that asked for it, and nothing reaches the UI until the
+ * finger is lifted - lv_indev_reset() + lv_indev_wait_release().
+ */
+struct IndevModel {
+    bool down       = false;
+    bool waiting    = false;
+    uint32_t clicks = 0;
+    uint32_t presses = 0;
+
+    void read(const TouchFilter::Report& report) {
+        if (waiting) {
+            waiting = report.pressed;
+        }
+        else if (report.pressed && !down) {
+            down = true;
+            presses++;
+        }
+        else if (!report.pressed && down) {
+            down = false;
+            clicks++;
+        }
+        if (report.cancel) {
+            down = false;
+            waiting = true;
+        }
+    }
+};
+
+// The idle frame stands for the interrupt line going inactive
+static bool is_idle(const Dump& dump) {
+    return dump[GestureMapper::REG_GESTURE] == 0 && (dump[GestureMapper::REG_POINTS] & 0x0F) == 0 && dump[2] == 0xFF;
+}
+
+template <size_t N>
+static std::vector<VolumioCommand> touch(TouchFilter& filter, IndevModel& ui, const Dump (&dumps)[N]) {
+    std::vector<VolumioCommand> commands;
+    for (const Dump& dump : dumps) {
+        TouchFilter::Report report = is_idle(dump) ? filter.release() : filter.feed(dump);
+        if (report.gesture)
+            commands.push_back(report.cmd);
+        ui.read(report);
+    }
+    return commands;
+}
+
+TEST(TouchFilter, SwipesNeverClick) {
+    TouchFilter filter;
+    IndevModel ui;
+    size_t commands = 0;
+    commands += touch(filter, ui, swipe_left).size();
+    commands += touch(filter, ui, swipe_right).size();
+    commands += touch(filter, ui, swipe_up).size();
+    commands += touch(filter, ui, swipe_down).size();
+    commands += touch(filter, ui, swipe_turn).size();
+
+    // The start points reached LVGL as presses, none of them ended as a click
+    CHECK_EQ(commands, (size_t)5);
+    CHECK_EQ(ui.presses, 5u);
+    CHECK_EQ(ui.clicks, 0u);
+    CHECK(!ui.waiting);
+}
+
+TEST(TouchFilter, GestureHoldsTheLastPoint) {
+    TouchFilter filter;
+    filter.feed(swipe_left[0]);
+    TouchFilter::Report report = filter.feed(swipe_left[2]);
+    CHECK(report.pressed);
+    CHECK_EQ(report.x, 0x82);
+
+    // The swipe is recognized further left - LVGL must not see the point move
+    report = filter.feed(swipe_left[3]);
+    CHECK(report.gesture);
+    CHECK(report.cancel);
+    CHECK(report.pressed);
+    CHECK_EQ(report.x, 0x82);
+    CHECK_EQ(report.y, 0x79);
+    CHECK(filter.isSuppressed());
+
+    // Rest of the touch is released for LVGL
+    report = filter.feed(swipe_left[4]);
+    CHECK(!report.pressed);
+    CHECK(!report.gesture);
+}
+
+TEST(TouchFilter, TapClicksOnce) {
+    TouchFilter filter;
+    IndevModel ui;
+    CHECK(touch(filter, ui, tap).empty());
+    CHECK(touch(filter, ui, zoom).empty());
+    CHECK_EQ(ui.presses, 2u);
+    CHECK_EQ(ui.clicks, 2u);
+}
+
+TEST(TouchFilter, WakeTouchSuppressed) {
+    TouchFilter filter;
+    IndevModel ui;
+    filter.suppress();
+    CHECK(touch(filter, ui, tap).empty());
+    CHECK_EQ(ui.presses, 0u);
+
+    // Suppressed up to the release only
+    touch(filter, ui, tap);
+    CHECK_EQ(ui.clicks, 1u);
+}
+
+TEST(TouchFilter, SwipeThenTap) {
+    TouchFilter filter;
+    IndevModel ui;
+    CHECK_EQ(touch(filter, ui, swipe_up).size(), (size_t)1);
+    CHECK(touch(filter, ui, tap).empty());
+    CHECK_EQ(ui.clicks, 1u);
+}
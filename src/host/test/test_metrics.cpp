@@ -0,0 +1,60 @@
+/**
+ * @brief metrics_printf overflow handling of the /metrics page buffer
+ */
+#include "host_test.h"
+#include "notify/Metrics.h"
+#include <cstring>
+
+TEST(Metrics, PrintfAppends) {
+    char buffer[32];
+    size_t len = metrics_printf(buffer, sizeof(buffer), 0, "a %u\n", 1u);
+    len = metrics_printf(buffer, sizeof(buffer), len, "b %u\n", 2u);
+    CHECK_EQ(len, (size_t)8);
+    CHECK_EQ(std::string(buffer), std::string("a 1\nb 2\n"));
+}
+
+TEST(Metrics, OverflowCutsToCompleteLines) {
+    char buffer[32];
+    size_t len = 0;
+    len = metrics_printf(buffer, sizeof(buffer), len, "line_one 1\n");             // 11 B
+    CHECK_EQ(len, (size_t)11);
+
+    // Two lines, the second does not fit - the first is kept, the partial one cut
+    len = metrics_printf(buffer, sizeof(buffer), len, "line_two 2\nline_three 3\n");
+    CHECK_EQ(len, sizeof(buffer));
+    CHECK_EQ(std::string(buffer), std::string("line_one 1\nline_two 2\n"));
+
+    // Overflowed - a shorter line that would fit is not appended after the gap
+    len = metrics_printf(buffer, sizeof(buffer), len, "x 1\n");
+    CHECK_EQ(len, sizeof(buffer));
+    CHECK_EQ(std::string(buffer), std::string("line_one 1\nline_two 2\n"));
+}
+
+TEST(Metrics, OverflowOfTheFirstLine) {
+    char buffer[8];
+    size_t len = metrics_printf(buffer, sizeof(buffer), 0, "much_too_long 1\n");
+    CHECK_EQ(len, sizeof(buffer));
+    CHECK_EQ(strlen(buffer), (size_t)0);
+}
+
+TEST(Metrics, ExactFit) {
+    char buffer[8];
+    size_t len = metrics_printf(buffer, sizeof(buffer), 0, "abcdef\n");   // 7 B + NUL
+    CHECK_EQ(len, (size_t)7);
+    len = metrics_printf(buffer, sizeof(buffer), len, "\n");
+    CHECK_EQ(len, sizeof(buffer));
+    CHECK_EQ(std::string(buffer), std::string("abcdef\n"));
+}
+
+TEST(Metrics, RenderReportsOverflow) {
+    char buffer[256];
+    size_t len = Metrics::getInstance().render(buffer, sizeof(buffer), 0);
+    CHECK_EQ(len, sizeof(buffer));
+    size_t text = strlen(buffer);
+    CHECK(text > 0 && buffer[text - 1] == '\n');
+
+    static char page[METRICS_BUFFER];
+    len = Metrics::getInstance().render(page, sizeof(page), 0);
+    CHECK(len < sizeof(page));
+    CHECK_EQ(page[len - 1], '\n');
+}
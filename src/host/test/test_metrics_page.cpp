@@ -0,0 +1,63 @@
+/**
+ * @brief The full /metrics page against METRICS_BUFFER
+ */
+#include "host_test.h"
+#include "webserver/MetricsPage.h"
+#include <cstring>
+
+#define TASK_NAME_MAX   16      // configMAX_TASK_NAME_LEN on the device, NUL included
+
+// Every value of the page at its widest
+static MetricsPage widest_page(void) {
+    static const char* names[] = {"loopTask_______", "async_tcp______", "WiFiTask_______",
+                                  "DisplayTask____", "ButtonTask_____", "lvglDraw_______"};
+    static_assert(sizeof(names) / sizeof(names[0]) >= METRICS_MAX_TASKS, "a name per task");
+
+    MetricsPage page;
+    page.heap_free      = UINT32_MAX;
+    page.heap_min_free  = UINT32_MAX;
+    page.uptime         = UINT32_MAX;
+    page.task_count     = METRICS_MAX_TASKS;
+    for (size_t i = 0; i < METRICS_MAX_TASKS; i++) {
+        CHECK(strlen(names[i]) < TASK_NAME_MAX);
+        page.tasks[i] = {names[i], UINT32_MAX};
+    }
+    page.wifi_connected   = true;
+    page.rssi             = -128;
+    page.connect_attempts = UINT32_MAX;
+    page.reconnects       = UINT32_MAX;
+    page.last_outage      = UINT32_MAX;
+    page.players          = UINT32_MAX;
+    page.players_online   = UINT32_MAX;
+    page.config.reads = page.config.updates = page.config.writes = UINT32_MAX;
+    page.config.skipped = page.config.load_us = page.config.last_write_us = UINT32_MAX;
+    page.journal.journaled = page.journal.compacted = page.journal.overflows = UINT32_MAX;
+    page.journal.expired = page.journal.deduped = page.journal.replayed = UINT32_MAX;
+    return page;
+}
+
+TEST(MetricsPage, FitsTheBuffer) {
+    static char buffer[METRICS_BUFFER];
+    size_t len = metrics_render_page(widest_page(), buffer, sizeof(buffer));
+    CHECK(len < sizeof(buffer));
+    CHECK_EQ(strlen(buffer), len);
+    CHECK_EQ(buffer[len - 1], '\n');
+
+    // Last section of the page made it
+    CHECK(strstr(buffer, "queue_dropped_total{queue=\"event_stream\"} ") != nullptr);
+
+    // Room left for the histogram counters to grow - up to 10 digits per sample, 20 for sums
+    size_t lines = 0;
+    for (size_t i = 0; i < len; i++)
+        lines += buffer[i] == '\n' ? 1 : 0;
+    CHECK(len + lines * 19 < sizeof(buffer));
+}
+
+TEST(MetricsPage, SmallBufferAnswersTruncated) {
+    // Previous METRICS_BUFFER - the journal lines pushed the page past it
+    static char buffer[4096];
+    size_t len = metrics_render_page(widest_page(), buffer, sizeof(buffer));
+    CHECK_EQ(len, sizeof(buffer));
+    size_t text = strlen(buffer);
+    CHECK(text > 0 && buffer[text - 1] == '\n');
+}
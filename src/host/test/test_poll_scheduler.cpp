@@ -0,0 +1,188 @@
+/**
+ * @brief PollScheduler priority, backoff and jitter
+ */
+#include "host_test.h"
+#include "volumio/PollScheduler.h"
+
+#define JITTER_MAX(period)  ((period) * POLL_JITTER / 100)
+
+// Reports one poll of the player at now_ms, returns the delay until its next one
+static uint32_t poll(PollScheduler& scheduler, uint8_t index, uint32_t now_ms, bool success) {
+    scheduler.done(index, now_ms, success);
+    return scheduler.getDue(index) - now_ms;
+}
+
+TEST(PollScheduler, SelectedFirst) {
+    PollScheduler scheduler;
+    scheduler.setCount(3);
+    scheduler.select(1, 0);
+    CHECK_EQ(scheduler.getSelected(), 1);
+
+    // Everything is due - the selected player wins, then the most overdue
+    CHECK_EQ(scheduler.next(0), 1);
+    scheduler.done(1, 0, true);
+    CHECK_EQ(scheduler.next(0), 0);
+    scheduler.done(0, 0, true);
+    CHECK_EQ(scheduler.next(0), 2);
+    scheduler.done(2, 0, true);
+    CHECK_EQ(scheduler.next(0), -1);
+
+    // Selected is due again before the overdue background players
+    CHECK_EQ(scheduler.next(POLL_SELECTED), 1);
+    CHECK_EQ(scheduler.next(POLL_BACKGROUND + JITTER_MAX(POLL_BACKGROUND)), 1);
+}
+
+TEST(PollScheduler, SelectedHasNoJitter) {
+    PollScheduler scheduler;
+    scheduler.setCount(2);
+    scheduler.select(0, 0);
+    for (uint32_t now = 0; now < 10000; now += POLL_SELECTED)
+        CHECK_EQ(poll(scheduler, 0, now, true), (uint32_t)POLL_SELECTED);
+
+    // Unreachable selected player - retried at POLL_BACKGROUND, no backoff
+    for (int i = 0; i < 6; i++)
+        CHECK_EQ(poll(scheduler, 0, 20000 + i * POLL_BACKGROUND, false), (uint32_t)POLL_BACKGROUND);
+}
+
+TEST(PollScheduler, BackgroundJitter) {
+    PollScheduler scheduler;
+    scheduler.setCount(2);
+    scheduler.select(0, 0);
+
+    uint32_t shortest = UINT32_MAX;
+    uint32_t longest  = 0;
+    for (int i = 0; i < 200; i++) {
+        uint32_t delay = poll(scheduler, 1, i * 10000, true);
+        CHECK(delay >= POLL_BACKGROUND && delay <= POLL_BACKGROUND + JITTER_MAX(POLL_BACKGROUND));
+        shortest = delay < shortest ? delay : shortest;
+        longest  = delay > longest ? delay : longest;
+    }
+    // Spread over most of the jitter range
+    CHECK(longest - shortest > JITTER_MAX(POLL_BACKGROUND) * 8 / 10);
+}
+
+TEST(PollScheduler, JitterIsDeterministic) {
+    PollScheduler a;
+    PollScheduler b;
+    for (PollScheduler* scheduler : {&a, &b}) {
+        scheduler->setCount(4);
+        scheduler->select(0, 0);
+    }
+    for (uint32_t now = 0; now < 120000; now += 50) {
+        int index = a.next(now);
+        CHECK_EQ(b.next(now), index);
+        CHECK_EQ(b.wait(now), a.wait(now));
+        if (index >= 0) {
+            a.done(index, now, index != 2);
+            b.done(index, now, index != 2);
+        }
+    }
+}
+
+TEST(PollScheduler, PlayersPolledTogetherDrift) {
+    // Configured at the same time - the next background polls land in different passes
+    PollScheduler scheduler;
+    scheduler.setCount(4);
+    scheduler.select(0, 0);
+    uint32_t due[4] = {};
+    for (uint8_t i = 1; i < 4; i++)
+        due[i] = poll(scheduler, i, 0, true);
+    CHECK(due[1] != due[2]);
+    CHECK(due[2] != due[3]);
+    CHECK(due[1] != due[3]);
+}
+
+TEST(PollScheduler, OfflineBackoff) {
+    PollScheduler scheduler;
+    scheduler.setCount(2);
+    scheduler.select(0, 0);
+
+    const uint32_t expected[] = {10000, 20000, 30000, 30000, 30000, 30000};
+    uint32_t now = 0;
+    for (uint32_t period : expected) {
+        uint32_t delay = poll(scheduler, 1, now, false);
+        CHECK(delay >= period && delay <= period + JITTER_MAX(period));
+        now += delay;
+    }
+
+    // Back online - normal period again
+    uint32_t delay = poll(scheduler, 1, now, true);
+    CHECK(delay >= POLL_BACKGROUND && delay <= POLL_BACKGROUND + JITTER_MAX(POLL_BACKGROUND));
+}
+
+TEST(PollScheduler, SelectPollsRightAway) {
+    PollScheduler scheduler;
+    scheduler.setCount(3);
+    scheduler.select(0, 0);
+    scheduler.done(0, 0, true);
+    scheduler.done(1, 0, true);
+    scheduler.done(2, 0, true);
+    CHECK_EQ(scheduler.next(100), -1);
+
+    scheduler.select(2, 100);
+    CHECK_EQ(scheduler.next(100), 2);
+    CHECK_EQ(scheduler.wait(100), 0u);
+    CHECK_EQ(poll(scheduler, 2, 100, true), (uint32_t)POLL_SELECTED);
+
+    scheduler.select(7, 200);       // Out of range - ignored
+    CHECK_EQ(scheduler.getSelected(), 2);
+}
+
+TEST(PollScheduler, CountIsBounded) {
+    PollScheduler scheduler;
+    scheduler.setCount(3);
+    scheduler.select(2, 0);
+    scheduler.setCount(MAX_PLAYERS + 3);
+    CHECK_EQ(scheduler.getCount(), MAX_PLAYERS);
+    CHECK_EQ(scheduler.getSelected(), 2);
+    scheduler.setCount(2);
+    CHECK_EQ(scheduler.getSelected(), 0);
+
+    PollScheduler empty;
+    CHECK_EQ(empty.next(0), -1);
+    CHECK_EQ(empty.wait(0), (uint32_t)POLL_BACKGROUND);
+}
+
+TEST(PollScheduler, LoadMix) {
+    // Four players, 40 ms per fetch, the third one unreachable - one poll per pass like the WiFi task
+    PollScheduler scheduler;
+    scheduler.setCount(4);
+    scheduler.select(1, 0);
+    uint32_t polls[4] = {};
+    uint32_t now = 0;
+    while (now < 60000) {
+        int index = scheduler.next(now);
+        if (index < 0) {
+            uint32_t wait = scheduler.wait(now);
+            now += wait < 10 ? wait : 10;
+            continue;
+        }
+        now += 40;
+        scheduler.done(index, now, index != 2);
+        polls[index]++;
+    }
+    CHECK(polls[1] >= 60000 / (POLL_SELECTED + 40 + 10));
+    CHECK(polls[0] >= 60000 / (POLL_BACKGROUND + JITTER_MAX(POLL_BACKGROUND) + 50) && polls[0] <= 60000 / POLL_BACKGROUND + 1);
+    CHECK(polls[3] >= 60000 / (POLL_BACKGROUND + JITTER_MAX(POLL_BACKGROUND) + 50) && polls[3] <= 60000 / POLL_BACKGROUND + 1);
+    CHECK(polls[2] >= 3 && polls[2] <= 5);      // 0, 10 s, 30 s, 60 s
+}
+
+TEST(PollScheduler, IdleSelectedPeriod) {
+    PollScheduler scheduler;
+    scheduler.setCount(1);
+    scheduler.select(0, 0);
+    scheduler.setSelectedPeriod(5000, 0);
+    scheduler.done(0, 0, true);
+    CHECK_EQ(scheduler.next(POLL_SELECTED), -1);
+    CHECK_EQ(scheduler.wait(POLL_SELECTED), 5000u - POLL_SELECTED);
+
+    // Failing while idle - never faster than the idle period
+    scheduler.done(0, 5000, false);
+    CHECK_EQ(scheduler.wait(5000), 5000u);
+
+    // Back to the default - due again within POLL_SELECTED, not after the idle period
+    scheduler.done(0, 10000, true);
+    scheduler.setSelectedPeriod(0, 10100);
+    CHECK_EQ(scheduler.getSelectedPeriod(), (uint32_t)POLL_SELECTED);
+    CHECK_EQ(scheduler.wait(10100), (uint32_t)POLL_SELECTED);
+}
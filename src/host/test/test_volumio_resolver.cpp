@@ -0,0 +1,255 @@
+/**
+ * @brief VolumioResolver against a counting stand-in backend
+ */
+#include "host_test.h"
+#include "volumio/VolumioResolver.h"
+#include <map>
+
+#define ADDR_A  0x1401A8C0      // 192.168.1.20
+#define ADDR_B  0x1501A8C0      // 192.168.1.21
+
+/**
+ * @brief Answers from tables and counts the queries per kind
+ */
+class FakeBackend : public ResolverBackend {
+public:
+    std::map<std::string, uint32_t> mdns;
+    std::map<std::string, uint32_t> dns;
+    std::vector<Service> services;
+    int mdns_queries = 0;
+    int dns_queries  = 0;
+    int browses      = 0;
+    std::string last_query;
+
+    uint32_t queryHost(const std::string& name, uint32_t timeout_ms) override {
+        mdns_queries++;
+        last_query = name;
+        CHECK_EQ(timeout_ms, (uint32_t)RESOLVER_TIMEOUT);
+        auto it = mdns.find(name);
+        return it != mdns.end() ? it->second : 0;
+    }
+
+    uint32_t lookupDns(const std::string& name) override {
+        dns_queries++;
+        last_query = name;
+        auto it = dns.find(name);
+        return it != dns.end() ? it->second : 0;
+    }
+
+    size_t browse(const char* service, const char* proto, uint32_t timeout_ms, std::vector<Service>& found) override {
+        browses++;
+        CHECK_EQ(timeout_ms, (uint32_t)RESOLVER_TIMEOUT);
+        CHECK_EQ(std::string(service), std::string(VOLUMIO_SERVICE));
+        CHECK_EQ(std::string(proto), std::string(VOLUMIO_SERVICE_PROTO));
+        found = services;
+        return found.size();
+    }
+
+    int queries(void) const { return mdns_queries + dns_queries + browses; }
+};
+
+TEST(VolumioResolver, LiteralAddressPassesThrough) {
+    FakeBackend backend;
+    VolumioResolver resolver(backend);
+    std::string address;
+    CHECK(resolver.resolve("192.168.1.20", 1000, address));
+    CHECK_EQ(address, std::string("192.168.1.20"));
+    CHECK_EQ(backend.queries(), 0);
+    CHECK_EQ(resolver.getLookups(), 0u);
+
+    // Not an address - looked up as a name
+    CHECK(!resolver.resolve("192.168.1.256", 1000, address));
+    CHECK(!resolver.resolve("192.168.1", 1000, address));
+    CHECK_EQ(backend.dns_queries, 2);
+}
+
+TEST(VolumioResolver, ParseAndFormat) {
+    uint32_t address = 0;
+    CHECK(VolumioResolver::parseAddress("192.168.1.20", address));
+    CHECK_EQ(address, (uint32_t)ADDR_A);
+    CHECK_EQ(VolumioResolver::formatAddress(ADDR_B), std::string("192.168.1.21"));
+    CHECK(VolumioResolver::parseAddress("0.0.0.0", address));
+    CHECK(!VolumioResolver::parseAddress("1.2.3.4.5", address));
+    CHECK(!VolumioResolver::parseAddress("1..2.3", address));
+    CHECK(!VolumioResolver::parseAddress("1.2.3.", address));
+    CHECK(!VolumioResolver::parseAddress("0001.2.3.4", address));
+    CHECK(!VolumioResolver::parseAddress("volumio", address));
+}
+
+TEST(VolumioResolver, MdnsTtl) {
+    FakeBackend backend;
+    backend.mdns["volumio"] = ADDR_A;
+    VolumioResolver resolver(backend);
+    std::string address;
+
+    CHECK(resolver.resolve("volumio.local", 1000, address));
+    CHECK_EQ(address, std::string("192.168.1.20"));
+    CHECK_EQ(backend.last_query, std::string("volumio"));
+
+    // Cached for the mDNS TTL
+    CHECK(resolver.resolve("volumio.local", 1000 + RESOLVER_TTL - 1, address));
+    CHECK_EQ(backend.mdns_queries, 1);
+    CHECK_EQ(resolver.getHits(), 1u);
+
+    // Expired - asked again, the new address is used
+    backend.mdns["volumio"] = ADDR_B;
+    CHECK(resolver.resolve("volumio.local", 1000 + RESOLVER_TTL + 1, address));
+    CHECK_EQ(backend.mdns_queries, 2);
+    CHECK_EQ(address, std::string("192.168.1.21"));
+}
+
+TEST(VolumioResolver, DnsTtl) {
+    FakeBackend backend;
+    backend.dns["nas.lan"] = ADDR_A;
+    VolumioResolver resolver(backend);
+    std::string address;
+
+    CHECK(resolver.resolve("nas.lan", 0, address));
+    CHECK(resolver.resolve("nas.lan", RESOLVER_TTL + 1000, address));       // Longer than mDNS
+    CHECK_EQ(backend.dns_queries, 1);
+    CHECK_EQ(backend.mdns_queries, 0);
+    CHECK(resolver.resolve("nas.lan", RESOLVER_DNS_TTL + 1000, address));
+    CHECK_EQ(backend.dns_queries, 2);
+}
+
+TEST(VolumioResolver, NegativeCache) {
+    FakeBackend backend;
+    VolumioResolver resolver(backend);
+    std::string address;
+
+    CHECK(!resolver.resolve("volumio.local", 1000, address));
+    CHECK_EQ(resolver.getFailures(), 1u);
+
+    // Not repeated within the retry time
+    for (uint32_t t = 1000; t < 1000 + RESOLVER_RETRY; t += 200)
+        CHECK(!resolver.resolve("volumio.local", t, address));
+    CHECK_EQ(backend.mdns_queries, 1);
+
+    // Host appears - found with the next lookup after the retry time
+    backend.mdns["volumio"] = ADDR_A;
+    CHECK(resolver.resolve("volumio.local", 1000 + RESOLVER_RETRY + 1, address));
+    CHECK_EQ(backend.mdns_queries, 2);
+    CHECK_EQ(address, std::string("192.168.1.20"));
+}
+
+TEST(VolumioResolver, MissesBackOff) {
+    FakeBackend backend;
+    VolumioResolver resolver(backend);
+    std::string address;
+
+    // Each lookup of a missing host blocks - retried after 5, 10, 20, 40 s, then every 60 s
+    uint32_t now = 0;
+    uint32_t expected[] = {RESOLVER_RETRY, 2 * RESOLVER_RETRY, 4 * RESOLVER_RETRY, 8 * RESOLVER_RETRY,
+                           RESOLVER_RETRY_MAX, RESOLVER_RETRY_MAX};
+    for (uint32_t delay : expected) {
+        CHECK(!resolver.resolve("volumio.local", now, address));
+        int queries = backend.mdns_queries;
+        CHECK(!resolver.resolve("volumio.local", now + delay - 1, address));
+        CHECK_EQ(backend.mdns_queries, queries);
+        now += delay + 1;
+    }
+    CHECK_EQ(backend.mdns_queries, 6);
+
+    // Found again - the next miss starts over at RESOLVER_RETRY
+    backend.mdns["volumio"] = ADDR_A;
+    CHECK(resolver.resolve("volumio.local", now, address));
+    backend.mdns.clear();
+    resolver.invalidate("volumio.local");
+    CHECK(!resolver.resolve("volumio.local", now, address));
+    CHECK(!resolver.resolve("volumio.local", now + RESOLVER_RETRY + 1, address));
+    CHECK_EQ(backend.mdns_queries, 9);
+}
+
+TEST(VolumioResolver, StaleKeptOnFailedRefresh) {
+    FakeBackend backend;
+    backend.mdns["volumio"] = ADDR_A;
+    VolumioResolver resolver(backend);
+    std::string address;
+    CHECK(resolver.resolve("volumio.local", 0, address));
+
+    // Refresh fails - the old address is kept and retried after RESOLVER_RETRY
+    backend.mdns.clear();
+    uint32_t expired = RESOLVER_TTL + 10;
+    CHECK(resolver.resolve("volumio.local", expired, address));
+    CHECK_EQ(address, std::string("192.168.1.20"));
+    CHECK_EQ(resolver.getFailures(), 1u);
+    CHECK(resolver.resolve("volumio.local", expired + RESOLVER_RETRY - 1, address));
+    CHECK_EQ(backend.mdns_queries, 2);
+    CHECK(resolver.resolve("volumio.local", expired + RESOLVER_RETRY + 1, address));
+    CHECK_EQ(backend.mdns_queries, 3);
+    CHECK_EQ(address, std::string("192.168.1.20"));
+
+    // Missed again - the next refresh waits twice as long
+    CHECK(resolver.resolve("volumio.local", expired + 3 * RESOLVER_RETRY, address));
+    CHECK_EQ(backend.mdns_queries, 3);
+}
+
+TEST(VolumioResolver, InvalidateForcesLookup) {
+    FakeBackend backend;
+    backend.mdns["volumio"] = ADDR_A;
+    VolumioResolver resolver(backend);
+    std::string address;
+    CHECK(resolver.resolve("volumio.local", 0, address));
+
+    // Request to the address failed - a new lookup right away, no stale fallback
+    backend.mdns.clear();
+    resolver.invalidate("volumio.local");
+    CHECK(!resolver.resolve("volumio.local", 100, address));
+    CHECK_EQ(backend.mdns_queries, 2);
+
+    resolver.invalidate("unknown.local");      // No entry - no effect
+}
+
+TEST(VolumioResolver, Discovery) {
+    FakeBackend backend;
+    VolumioResolver resolver(backend);
+    std::string address;
+
+    CHECK(!resolver.resolve("auto", 0, address));
+    CHECK_EQ(backend.browses, 1);
+
+    // First responder with an address wins, empty setting browses too
+    backend.services = {{"volumio-kitchen", 0, 3000}, {"volumio-living", ADDR_B, 3000}, {"volumio", ADDR_A, 3000}};
+    CHECK(resolver.resolve("", 0, address));
+    CHECK_EQ(address, std::string("192.168.1.21"));
+    CHECK_EQ(backend.browses, 2);
+    CHECK_EQ(backend.mdns_queries + backend.dns_queries, 0);
+}
+
+TEST(VolumioResolver, LeastRecentlyUsedEvicted) {
+    FakeBackend backend;
+    const char* names[] = {"a", "b", "c", "d", "e"};
+    for (uint32_t i = 0; i < 5; i++)
+        backend.mdns[names[i]] = ADDR_A + (i << 24);
+    VolumioResolver resolver(backend);
+    std::string address;
+
+    for (uint32_t i = 0; i < RESOLVER_CACHE_SIZE; i++)
+        CHECK(resolver.resolve(std::string(names[i]) + ".local", 100 + i, address));
+    CHECK(resolver.resolve("a.local", 200, address));      // "b" is now the oldest
+    CHECK_EQ(backend.mdns_queries, RESOLVER_CACHE_SIZE);
+
+    CHECK(resolver.resolve("e.local", 300, address));
+    CHECK_EQ(backend.mdns_queries, RESOLVER_CACHE_SIZE + 1);
+
+    CHECK(resolver.resolve("a.local", 400, address));
+    CHECK(resolver.resolve("c.local", 400, address));
+    CHECK(resolver.resolve("d.local", 400, address));
+    CHECK_EQ(backend.mdns_queries, RESOLVER_CACHE_SIZE + 1);
+    CHECK(resolver.resolve("b.local", 400, address));
+    CHECK_EQ(backend.mdns_queries, RESOLVER_CACHE_SIZE + 2);
+}
+
+TEST(VolumioResolver, ClockWrap) {
+    FakeBackend backend;
+    backend.mdns["volumio"] = ADDR_A;
+    VolumioResolver resolver(backend);
+    std::string address;
+    uint32_t start = 0xFFFFFFFFu - 1000;
+
+    CHECK(resolver.resolve("volumio.local", start, address));
+    CHECK(resolver.resolve("volumio.local", start + RESOLVER_TTL / 2, address));
+    CHECK_EQ(backend.mdns_queries, 1);
+    CHECK(resolver.resolve("volumio.local", start + RESOLVER_TTL + 2, address));
+    CHECK_EQ(backend.mdns_queries, 2);
+}
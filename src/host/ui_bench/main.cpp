@@ -0,0 +1,441 @@
+/**
+ * @brief Headless render benchmark of the dashboard
+ *
+ * Builds the LVGL UI against a memory framebuffer and drives scripted
+ * scenarios (seek ticks, track changes, popups, arc drag, long titles).
+ * For every scenario it reports the CPU time per rendered frame, the
+ * invalidated and flushed area per frame and the heap used by the UI.
+ *
+ * Scenarios marked (ref) render the widget an optimization replaced, next
+ * to the current widget on an otherwise blank screen, so both variants of a
+ * change can be compared in one run.
+ *
+ * Time is virtual (host_clock), so animations and timers behave the same
+ * on every run; only the measured render time depends on the machine.
+ *
+ * The native_ui_2units environment renders with two software draw units
+ * (LVGL pthread port), for a 1 vs. 2 unit comparison of the same scenarios.
+ *
+ * Usage: program [--dump]   --dump writes the framebuffer of every scenario to <scenario>.ppm
+ */
+#include <lvgl.h>
+#include "lvgl/dashboard.h"
+#include "lvgl/cache/icon_cache.h"
+#include "lvgl/widgets/arc_track.h"
+#include "notify/CommandQueue.h"
+#include "host_clock.h"
+#include "reference.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <sys/types.h>
+#if defined(__GLIBC__)
+    #include <malloc.h>
+#endif
+
+#define HOST_LCD_WIDTH      240
+#define HOST_LCD_HEIGHT     240
+#define HOST_BUF_LINES      60      // Same stripe height as the device (DISPLAY_BUF_LINES)
+#define HOST_FRAME_PERIOD   10      // Virtual time per lv_timer_handler call [ms]
+
+// Memory framebuffer and LVGL draw buffer
+static uint16_t framebuffer[HOST_LCD_WIDTH * HOST_LCD_HEIGHT];
+static uint8_t draw_buf[HOST_LCD_WIDTH * HOST_BUF_LINES * 2];
+
+// Scripted pointer input
+static lv_point_t pointer_pos = {0, 0};
+static bool pointer_pressed = false;
+
+static bool dump_frames = false;
+
+// Screen of the running A/B scenario and the teardown of its widgets
+static lv_obj_t* bench_screen = nullptr;
+static std::function<void()> bench_cleanup;
+
+struct ScenarioStats {
+    uint32_t steps          = 0;
+    uint32_t frames         = 0;    // steps that rendered something
+    uint64_t render_ns      = 0;
+    uint64_t max_render_ns  = 0;
+    uint64_t invalidated_px = 0;
+    uint64_t flushed_px     = 0;
+    uint32_t commands       = 0;    // commands posted to the CommandQueue
+
+    void reset(void) { *this = ScenarioStats(); }
+};
+
+static ScenarioStats stats;
+
+static uint32_t host_tick(void) {
+    return host_clock_ms();
+}
+
+static size_t heap_in_use(void) {
+    #if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+        return mallinfo2().uordblks;
+    #else
+        return 0;
+    #endif
+}
+
+static void display_flush(lv_display_t *display, const lv_area_t *area, uint8_t *data) {
+    int32_t w = lv_area_get_width(area);
+    const uint16_t* src = reinterpret_cast<const uint16_t*>(data);
+
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&framebuffer[y * HOST_LCD_WIDTH + area->x1], src, w * sizeof(uint16_t));
+        src += w;
+    }
+    stats.flushed_px += lv_area_get_size(area);
+
+    lv_display_flush_ready(display);
+}
+
+static void display_invalidate_cb(lv_event_t *e) {
+    const lv_area_t* area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+    if (area != nullptr)
+        stats.invalidated_px += lv_area_get_size(area);
+}
+
+static void pointer_read(lv_indev_t *indev, lv_indev_data_t *data) {
+    data->point = pointer_pos;
+    data->state = pointer_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void dump_framebuffer(const char* name) {
+    std::string path = std::string(name) + ".ppm";
+    for (char& c : path) {
+        if (c == ' ' || c == '/') c = '_';
+    }
+
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == nullptr)
+        return;
+
+    fprintf(f, "P6\n%d %d\n255\n", HOST_LCD_WIDTH, HOST_LCD_HEIGHT);
+    for (uint16_t px : framebuffer) {
+        uint8_t rgb[3] = {
+            (uint8_t)(((px >> 11) & 0x1F) << 3),
+            (uint8_t)(((px >> 5) & 0x3F) << 2),
+            (uint8_t)((px & 0x1F) << 3),
+        };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+// Advance the virtual clock by one frame period and run LVGL
+static void step(void) {
+    host_clock_advance(HOST_FRAME_PERIOD);
+
+    uint64_t flushed_before = stats.flushed_px;
+    auto start = std::chrono::steady_clock::now();
+    lv_timer_handler();
+    uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    stats.steps++;
+    if (stats.flushed_px != flushed_before) {
+        stats.frames++;
+        stats.render_ns += elapsed;
+        if (elapsed > stats.max_render_ns)
+            stats.max_render_ns = elapsed;
+    }
+
+    // Stand-in for the WiFi task - drain the command queue
+    VolumioCommand cmd;
+    while (CommandQueue::getInstance().getNextCommand(cmd)) {
+        stats.commands++;
+    }
+}
+
+static void run(uint32_t duration_ms) {
+    for (uint32_t t = 0; t < duration_ms; t += HOST_FRAME_PERIOD) {
+        step();
+    }
+}
+
+// Let animations and timers settle so scenarios don't leak into each other
+static void settle(void) {
+    run(2000);
+}
+
+static lv_obj_t* open_bench_screen(void) {
+    bench_screen = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(bench_screen, BG_COLOR, LV_PART_MAIN);
+    lv_screen_load(bench_screen);
+    return bench_screen;
+}
+
+static void close_bench_screen(Dashboard* dashboard) {
+    if (bench_screen == nullptr)
+        return;
+
+    lv_screen_load(dashboard->GetScreen());
+    if (bench_cleanup)
+        bench_cleanup();
+    bench_cleanup = nullptr;
+    lv_obj_delete(bench_screen);
+    bench_screen = nullptr;
+}
+
+static void report(const char* name, size_t heap_before) {
+    uint32_t frames = stats.frames ? stats.frames : 1;
+    printf("%-22s %7u %7u %10.1f %10.1f %12llu %12llu %9zd %8u\n",
+           name,
+           stats.steps,
+           stats.frames,
+           stats.render_ns / 1000.0 / frames,
+           stats.max_render_ns / 1000.0,
+           (unsigned long long)(stats.invalidated_px / frames),
+           (unsigned long long)(stats.flushed_px / frames),
+           (ssize_t)(heap_in_use() - heap_before) / 1024,
+           stats.commands);
+
+    if (dump_frames)
+        dump_framebuffer(name);
+}
+
+static void load_track(Dashboard* dashboard, const char* title, const char* artist, const char* type,
+                       int seek, int duration) {
+    const Theme* theme = get_theme(type);
+    if (theme == nullptr)
+        theme = &default_theme;
+
+    dashboard->SetTrackTitle(title);
+    dashboard->SetTrackArtist(artist);
+    dashboard->SetTrackSamplerate("44.1 kHz - 16 bit");
+    dashboard->SetTrackSeek(seek, duration);
+    dashboard->SetStatus(true);
+    dashboard->SetRepeatIconState(false, false);
+    dashboard->SetRandomIconState(false);
+    dashboard->SetPlayerIcon(theme->icon);
+    dashboard->SetAccentColor(theme->color);
+}
+
+static void scenario_seek_ticks(Dashboard* dashboard) {
+    load_track(dashboard, "Short title", "Artist - Album", "mpd", 0, 300);
+    settle();
+    stats.reset();
+
+    for (int second = 1; second <= 30; second++) {
+        dashboard->SetTrackSeek(second, 300);
+        run(1000);
+    }
+}
+
+static void scenario_track_change(Dashboard* dashboard) {
+    settle();
+    stats.reset();
+
+    static const char* types[] = {"spotify", "youtube", "airplay", "mpd"};
+    for (int i = 0; i < 10; i++) {
+        std::string title = "Track " + std::to_string(i + 1) + (i % 2 ? " - with a much longer title that scrolls" : "");
+        load_track(dashboard, title.c_str(), "Artist - Album", types[i % 4], 0, 180 + i * 10);
+        run(2000);
+    }
+}
+
+static void scenario_popup(Dashboard* dashboard) {
+    settle();
+    stats.reset();
+
+    for (int i = 0; i < 5; i++) {
+        dashboard->ShowPopup("Volume", LV_SYMBOL_VOLUME_MAX, 1000);
+        run(1500);
+    }
+}
+
+// Same show / hold / hide cycle for both popups
+template <typename Popup>
+static void popup_cycles(Popup* popup, void (*show)(Popup*)) {
+    settle();
+    stats.reset();
+
+    for (int i = 0; i < 5; i++) {
+        show(popup);
+        run(1000);
+        popup->Hide();
+        run(500);
+    }
+}
+
+static void scenario_popup_resize_ref(Dashboard* dashboard) {
+    ResizePopup* popup = new ResizePopup(open_bench_screen());
+    bench_cleanup = [popup] { delete popup; };
+    popup_cycles<ResizePopup>(popup, [](ResizePopup* p) { p->Show("Volume", LV_SYMBOL_VOLUME_MAX); });
+}
+
+static void scenario_popup_layer(Dashboard* dashboard) {
+    lvgl_popup* popup = new lvgl_popup(open_bench_screen());
+    bench_cleanup = [popup] { delete popup; };
+    popup_cycles<lvgl_popup>(popup, [](lvgl_popup* p) { p->Show("Volume", LV_SYMBOL_VOLUME_MAX, 0); });
+}
+
+// Progress arc with the dashboard's geometry and style
+static lv_obj_t* create_seek_arc(lv_obj_t* parent) {
+    lv_obj_t* arc = lv_arc_create(parent);
+    lv_obj_align(arc, LV_ALIGN_CENTER, 0, 0);
+    lv_obj_set_size(arc, 225, 225);
+    lv_obj_set_style_bg_color(arc, ARC_KNOB_COLOR, LV_PART_KNOB);
+    lv_obj_set_style_arc_color(arc, ARC_BG_COLOR, LV_PART_MAIN);
+    lv_obj_set_style_arc_color(arc, ACCENT_COLOR, LV_PART_INDICATOR);
+    lv_obj_set_style_bg_opa(arc, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_arc_set_rotation(arc, 270);
+    lv_arc_set_bg_angles(arc, 180+55, 180-55);
+    lv_arc_set_range(arc, 0, 300);
+    lv_arc_set_value(arc, 0);
+    return arc;
+}
+
+// One seek tick per second - the arc alone, without the labels of the dashboard
+static void scenario_arc_plain_ref(Dashboard* dashboard) {
+    lv_obj_t* arc = create_seek_arc(open_bench_screen());
+    settle();
+    stats.reset();
+
+    for (int second = 1; second <= 30; second++) {
+        lv_arc_set_value(arc, second);
+        lv_arc_set_range(arc, 0, 300);
+        run(1000);
+    }
+}
+
+static void scenario_arc_track(Dashboard* dashboard) {
+    lv_obj_t* arc = create_seek_arc(open_bench_screen());
+    ArcTrack* track = new ArcTrack(arc, ARC_BG_COLOR);
+    bench_cleanup = [track] { delete track; };
+    settle();
+    stats.reset();
+
+    for (int second = 1; second <= 30; second++) {
+        lv_arc_set_value(arc, second);
+        run(1000);
+    }
+}
+
+// A long title scrolling for 10 s, with the dashboard's title font and width
+static const char* long_title = "A Very Long Track Title That Keeps Scrolling Across The Screen";
+
+static void scenario_title_label_ref(Dashboard* dashboard) {
+    lv_obj_t* label = lv_label_create(open_bench_screen());
+    lv_obj_set_width(label, 150);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+    lv_obj_set_style_text_align(label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    lv_obj_set_style_text_color(label, TEXT_COLOR, LV_PART_MAIN);
+    lv_obj_set_style_text_font(label, TITLE_FONT, LV_PART_MAIN);
+    lv_label_set_text(label, long_title);
+    lv_obj_align(label, LV_ALIGN_CENTER, 0, -55);
+    settle();
+    stats.reset();
+
+    run(10000);
+}
+
+static void scenario_title_strip(Dashboard* dashboard) {
+    ScrollLabel* label = new ScrollLabel(open_bench_screen());
+    bench_cleanup = [label] { delete label; };
+    label->SetFont(TITLE_FONT);
+    label->SetTextAlign(LV_TEXT_ALIGN_CENTER);
+    label->SetWidth(150);
+    label->SetText(long_title);
+    label->Align(LV_ALIGN_CENTER, 0, -55);
+    settle();
+    stats.reset();
+
+    run(10000);
+}
+
+static void scenario_arc_drag(Dashboard* dashboard) {
+    load_track(dashboard, "Short title", "Artist - Album", "mpd", 0, 300);
+    settle();
+    stats.reset();
+
+    // Drag the finger along the arc track from start to end, then release
+    const float center = HOST_LCD_WIDTH / 2.0f;
+    const float radius = 225 / 2.0f - 8;
+    pointer_pressed = true;
+    for (int angle = 150; angle <= 390; angle += 2) {
+        float rad = angle * (float)M_PI / 180.0f;
+        pointer_pos.x = (int32_t)(center + radius * cosf(rad));
+        pointer_pos.y = (int32_t)(center + radius * sinf(rad));
+        run(HOST_FRAME_PERIOD * 2);
+    }
+    pointer_pressed = false;
+    run(500);
+}
+
+static void scenario_long_title(Dashboard* dashboard) {
+    load_track(dashboard, "A Very Long Track Title That Keeps Scrolling Across The Screen",
+               "An Artist With A Long Name - And An Album Title", "spotify", 0, 300);
+    settle();
+    stats.reset();
+
+    run(10000);
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dump") == 0)
+            dump_frames = true;
+    }
+
+    lv_init();
+    lv_tick_set_cb(host_tick);
+
+    lv_display_t* display = lv_display_create(HOST_LCD_WIDTH, HOST_LCD_HEIGHT);
+    lv_display_set_color_format(display, LV_COLOR_FORMAT_RGB565);
+    lv_display_set_flush_cb(display, display_flush);
+    lv_display_set_buffers(display, draw_buf, NULL, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_add_event_cb(display, display_invalidate_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+
+    lv_indev_t* pointer = lv_indev_create();
+    lv_indev_set_type(pointer, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(pointer, pointer_read);
+
+    size_t heap_before = heap_in_use();
+    stats.reset();
+    Dashboard* dashboard = new Dashboard();
+    lv_screen_load(dashboard->GetScreen());
+    run(HOST_FRAME_PERIOD);
+
+    printf("draw units: %d\n\n", LV_DRAW_SW_DRAW_UNIT_CNT);
+    printf("%-22s %7s %7s %10s %10s %12s %12s %9s %8s\n",
+           "scenario", "steps", "frames", "avg [us]", "max [us]", "inval px/fr", "flush px/fr", "heap [KB]", "cmds");
+    report("boot", heap_before);
+
+    struct Scenario {
+        const char* name;
+        void (*run)(Dashboard*);
+    };
+    static const Scenario scenarios[] = {
+        {"seek ticks",      scenario_seek_ticks},
+        {"track change",    scenario_track_change},
+        {"popup show/hide", scenario_popup},
+        {"arc drag",        scenario_arc_drag},
+        {"long title",      scenario_long_title},
+        {"popup resize (ref)", scenario_popup_resize_ref},
+        {"popup layer",     scenario_popup_layer},
+        {"arc plain (ref)", scenario_arc_plain_ref},
+        {"arc track",       scenario_arc_track},
+        {"title label (ref)", scenario_title_label_ref},
+        {"title strip",     scenario_title_strip},
+    };
+
+    for (const Scenario& scenario : scenarios) {
+        scenario.run(dashboard);
+        report(scenario.name, heap_before);
+        close_bench_screen(dashboard);
+    }
+
+    IconCache& cache = IconCache::getInstance();
+    printf("\nicon cache: %zu entries, %zu / %zu B, hits %u, misses %u, evictions %u\n",
+           cache.GetEntryCount(), cache.GetUsage(), cache.GetBudget(),
+           cache.GetHits(), cache.GetMisses(), cache.GetEvictions());
+
+    delete dashboard;
+    return 0;
+}
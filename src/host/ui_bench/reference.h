@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @brief Earlier versions of optimized widgets, kept as benchmark baselines
+ *
+ * Each reference reproduces the drawing work of the code it replaced, so
+ * ui_bench can report both variants side by side on the same screen.
+ * Nothing here is built for the device.
+ */
+#include <lvgl.h>
+#include "lvgl/styles/styles.h"
+
+/**
+ * @brief Popup animated by resizing the container every step (before the layer snapshot)
+ */
+class ResizePopup {
+private:
+    lv_obj_t* popup         = nullptr;
+    lv_obj_t* title_label   = nullptr;
+    lv_obj_t* content_label = nullptr;
+
+    static void anim_popup_cb(void* var, int32_t v) {
+        lv_obj_t* popup = static_cast<lv_obj_t*>(var);
+        lv_obj_set_width(popup, lv_map(v, 0, 100, 0, POPUP_WIDTH));
+        lv_obj_set_height(popup, lv_map(v, 0, 100, 0, POPUP_HEIGHT));
+        lv_obj_set_style_text_opa(popup, lv_map(v, 0, 100, 0, POPUP_OPACITY), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(popup, lv_map(v, 0, 100, 0, POPUP_OPACITY), LV_PART_MAIN);
+    }
+
+    static void anim_completed_cb(lv_anim_t* a) {
+        lv_obj_add_flag(static_cast<lv_obj_t*>(a->var), LV_OBJ_FLAG_HIDDEN);
+    }
+
+    void animate(bool in) {
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, popup);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)anim_popup_cb);
+        lv_anim_set_duration(&a, POPUP_ANIMATION_DURATION);
+        lv_anim_set_path_cb(&a, in ? lv_anim_path_ease_out : lv_anim_path_ease_in);
+        lv_anim_set_values(&a, in ? 0 : 100, in ? 100 : 0);
+        if (!in)
+            lv_anim_set_completed_cb(&a, anim_completed_cb);
+        lv_anim_start(&a);
+    }
+
+public:
+    ResizePopup(lv_obj_t* parent) {
+        popup = lv_obj_create(parent);
+        lv_obj_set_size(popup, 0, 0);
+        lv_obj_add_flag(popup, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(popup, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_set_style_bg_color(popup, POPUP_BG_COLOR, LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(popup, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_border_width(popup, 1, LV_PART_MAIN);
+        lv_obj_set_style_border_color(popup, POPUP_BORDER_COLOR, LV_PART_MAIN);
+        lv_obj_set_style_radius(popup, 15, LV_PART_MAIN);
+
+        title_label = lv_label_create(popup);
+        lv_obj_align(title_label, LV_ALIGN_CENTER, 0, -25);
+        lv_obj_set_style_text_align(title_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_set_style_text_color(title_label, POPUP_TEXT_COLOR, LV_PART_MAIN);
+        lv_obj_set_style_text_font(title_label, POPUP_TITLE_FONT, LV_PART_MAIN);
+
+        content_label = lv_label_create(popup);
+        lv_obj_align(content_label, LV_ALIGN_CENTER, 0, 15);
+        lv_obj_set_width(content_label, POPUP_WIDTH - 20);
+        lv_label_set_long_mode(content_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
+        lv_obj_set_style_text_align(content_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+        lv_obj_set_style_text_color(content_label, POPUP_TEXT_COLOR, LV_PART_MAIN);
+        lv_obj_set_style_text_font(content_label, POPUP_CONTENT_FONT, LV_PART_MAIN);
+    }
+
+    ~ResizePopup() {
+        lv_anim_delete(popup, (lv_anim_exec_xcb_t)anim_popup_cb);
+        lv_obj_del(popup);
+    }
+
+    void Show(const char* title, const char* content) {
+        lv_label_set_text(title_label, title);
+        lv_label_set_text(content_label, content);
+        lv_obj_clear_flag(popup, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_align(popup, LV_ALIGN_CENTER, 0, 0);
+        animate(true);
+    }
+
+    void Hide(void) {
+        animate(false);
+    }
+};
@@ -0,0 +1,223 @@
+/**
+ * @brief Host simulation of the Volumio client against stand-in servers
+ *
+ * Runs the WiFi task's PlayerManager (Volumio, VolumioResolver, PollScheduler,
+ * CommandJournal, the notify queues) through the platform layer, with two
+ * scripted Volumio servers answering over the host HTTP stand-in. The script
+ * issues commands, takes a server and the WiFi link down and brings them back,
+ * then checks the state the servers ended up in and prints the metrics.
+ *
+ * Time is virtual (host_clock), every run is identical. Build with the native
+ * env, which enables AddressSanitizer and UBSan.
+ *
+ * Usage: program [--metrics]   --metrics prints the Prometheus text at the end
+ * Exit code is 1 if a server ended up in an unexpected state.
+ */
+#include "platform/platform.h"
+#include "volumio/PlayerManager.h"
+#include "notify/CommandQueue.h"
+#include "notify/NotificationManager.h"
+#include "notify/LatencyTracer.h"
+#include "notify/Metrics.h"
+#include "host_platform.h"
+#include "host_clock.h"
+
+#include <ArduinoJson.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define SIM_STEP            10      // Idle step of the virtual clock [ms]
+#define SIM_LATENCY         15      // Base response time of a server [ms]
+#define SIM_DURATION        70000   // [ms]
+
+/**
+ * @brief Stand-in Volumio REST API, one per address
+ */
+struct SimServer {
+    const char* address;
+    bool up             = true;
+    std::string status  = "pause";
+    std::string title   = "Track 1";
+    int track           = 1;
+    int seek            = 0;
+    int volume          = 50;
+    bool random         = false;
+    bool repeat         = false;
+    uint32_t requests   = 0;
+    uint32_t commands   = 0;
+
+    explicit SimServer(const char* address) : address(address) { }
+
+    std::string state(void) {
+        JsonDocument doc;
+        doc["status"]       = status;
+        doc["title"]        = title;
+        doc["artist"]       = "Artist";
+        doc["album"]        = "Album";
+        doc["trackType"]    = "flac";
+        doc["seek"]         = seek * 1000;
+        doc["duration"]     = 300;
+        doc["samplerate"]   = "44.1 kHz";
+        doc["bitdepth"]     = "16 bit";
+        doc["random"]       = random;
+        doc["repeat"]       = repeat;
+        doc["repeatSingle"] = false;
+        doc["volume"]       = volume;
+        std::string out;
+        serializeJson(doc, out);
+        return out;
+    }
+
+    void command(const std::string& cmd) {
+        commands++;
+        if (cmd == "play")                          status = "play";
+        else if (cmd == "pause")                    status = "pause";
+        else if (cmd == "toggle")                   status = (status == "play") ? "pause" : "play";
+        else if (cmd == "next" || cmd == "prev") {
+            track += (cmd == "next") ? 1 : -1;
+            title = "Track " + std::to_string(track);
+            seek  = 0;
+        }
+        else if (cmd.rfind("seek&position=", 0) == 0) seek = atoi(cmd.c_str() + strlen("seek&position="));
+        else if (cmd == "random")                   random = !random;
+        else if (cmd == "repeat")                   repeat = !repeat;
+        else if (cmd == "volume&volume=plus")       volume++;
+        else if (cmd == "volume&volume=minus")      volume--;
+    }
+
+    int get(const std::string& path, std::string* body) {
+        if (!up)
+            return -1;      // HTTPC_ERROR_CONNECTION_REFUSED
+        requests++;
+        host_clock_advance(SIM_LATENCY + requests % 7);
+
+        static const char* command_path = "/api/v1/commands/?cmd=";
+        if (path == "/api/v1/getState") {
+            *body = state();
+            return 200;
+        }
+        if (path.rfind(command_path, 0) == 0) {
+            command(path.substr(strlen(command_path)));
+            *body = "{\"response\":\"ok\"}";
+            return 200;
+        }
+        return 404;
+    }
+};
+
+static SimServer servers[] = {SimServer("192.168.1.20"), SimServer("192.168.1.21")};
+
+static int http_handler(const std::string& url, std::string* body) {
+    // http://<address>[:port]/path
+    size_t host_start = url.find("://") + 3;
+    size_t path_start = url.find('/', host_start);
+    std::string host  = url.substr(host_start, path_start - host_start);
+    host = host.substr(0, host.find(':'));
+
+    for (SimServer& server : servers) {
+        if (host == server.address)
+            return server.get(url.substr(path_start), body);
+    }
+    return -1;
+}
+
+/**
+ * @brief Scripted event at a point in virtual time
+ */
+struct SimEvent {
+    uint32_t at;
+    const char* name;
+    void (*run)(void);
+};
+
+static void post(VolumioCommandType type, int value = 0) {
+    VolumioCommand cmd = {type, value};
+    CommandQueue::getInstance().postCommand(cmd);
+}
+
+static const SimEvent script[] = {
+    {1000,  "play, volume +3",          [] { post(VolumioCommandType::TOGGLE);
+                                             for (int i = 0; i < 3; i++) post(VolumioCommandType::VOLUME, 1); }},
+    {5000,  "server A down",            [] { servers[0].up = false; }},
+    {7000,  "offline: volume +4, pause, seek 60",
+                                        [] { for (int i = 0; i < 4; i++) post(VolumioCommandType::VOLUME, 1);
+                                             post(VolumioCommandType::TOGGLE);
+                                             post(VolumioCommandType::SEEK, 60); }},
+    {8000,  "offline: random x2",       [] { post(VolumioCommandType::RANDOM); post(VolumioCommandType::RANDOM); }},
+    {15000, "server A up",              [] { servers[0].up = true; }},
+    {20000, "select next player",       [] { post(VolumioCommandType::SELECT_PLAYER, -1); }},
+    {21000, "next track",               [] { post(VolumioCommandType::NEXT); }},
+    {25000, "WiFi down",                [] { host_net_set(false); }},
+    {26000, "offline: play",            [] { post(VolumioCommandType::PLAY); }},
+    {28000, "WiFi up",                  [] { host_net_set(true); }},
+    {32000, "server B down: prev",      [] { servers[1].up = false; post(VolumioCommandType::PREV); }},
+    {65000, "server B up, prev expired",[] { servers[1].up = true; }},
+};
+
+static bool expect(const char* what, const std::string& actual, const std::string& expected) {
+    bool ok = actual == expected;
+    printf("  %-28s %-10s %s\n", what, actual.c_str(), ok ? "ok" : ("FAIL, expected " + expected).c_str());
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    bool print_metrics = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--metrics") == 0)
+            print_metrics = true;
+    }
+
+    host_http_handler(http_handler);
+    host_resolver_add("volumio", 0x1401A8C0);   // 192.168.1.20, first octet in the lowest byte
+
+    NotificationManager::getInstance().subscribe([](const NotificationEvent& event) {
+        printf("%7u ms  notification: %s - %s\n", platform_millis(), event.title.c_str(), event.content.c_str());
+    });
+
+    PlayerManager players;
+    uint32_t states = 0;
+    players.onState([&states](const Info&) { states++; });
+    players.Setup("volumio.local, 192.168.1.21");
+
+    size_t next_event = 0;
+    while (platform_millis() < SIM_DURATION) {
+        while (next_event < sizeof(script) / sizeof(script[0]) && platform_millis() >= script[next_event].at) {
+            printf("%7u ms  %s\n", platform_millis(), script[next_event].name);
+            script[next_event].run();
+            next_event++;
+        }
+        players.Update();
+        NotificationManager::getInstance().processNotifications();
+
+        // Idle until the next poll, like the task's delay
+        uint32_t wait = players.Wait();
+        platform_delay(wait > SIM_STEP ? SIM_STEP : (wait ? wait : 1));
+    }
+
+    const CommandJournal::Stats& journal = players.GetJournal().getStats();
+    printf("\nstates %u, journaled %u, compacted %u, replayed %u, deduplicated %u, expired %u, pending %zu\n",
+           states, journal.journaled, journal.compacted, journal.replayed, journal.deduped, journal.expired,
+           players.GetJournal().size());
+    for (const SimServer& server : servers) {
+        printf("server %s: %u requests, %u commands\n", server.address, server.requests, server.commands);
+    }
+
+    printf("\nfinal state\n");
+    bool ok = true;
+    ok &= expect("A status", servers[0].status, "pause");
+    ok &= expect("A volume", std::to_string(servers[0].volume), "57");
+    ok &= expect("A seek", std::to_string(servers[0].seek), "60");
+    ok &= expect("A random", servers[0].random ? "on" : "off", "off");
+    ok &= expect("B track", servers[1].title, "Track 2");
+    ok &= expect("B status", servers[1].status, "play");
+    ok &= expect("expired in the journal", std::to_string(journal.expired), "1");
+
+    if (print_metrics) {
+        static char buffer[METRICS_BUFFER];
+        size_t len = Metrics::getInstance().render(buffer, sizeof(buffer), 0);
+        printf("\n%s%s", buffer, len >= sizeof(buffer) ? "(truncated)\n" : "");
+        printf("\n%s\n", LatencyTracer::getInstance().toJson().c_str());
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "dev_tools.h"
+#include "lvgl.h"
+#include "../styles/styles.h"
+#include "text_raster.h"
+#include <string>
+#include <vector>
+
+#if ICON_CACHE_VERBOSE == true
+    #define ICON_CACHE_DEBUG_PRINTLN(s) DEBUG_PRINTLN(s);
+#else
+    #define ICON_CACHE_DEBUG_PRINTLN(s) ;
+#endif
+
+/**
+ * @brief Cache of pre-rasterized icon bitmaps
+ *
+ * Icons are rendered once per (text, font, color) and shared between widgets.
+ * Entries are reference counted - only unused entries are evicted (LRU) when
+ * the RAM budget is exceeded. If nothing can be evicted the bitmap is handed
+ * out uncached and freed with its last release.
+ */
+class IconCache {
+private:
+    struct Entry {
+        std::string text;
+        const lv_font_t* font;
+        uint32_t color;
+        lv_draw_buf_t* buf;
+        size_t size;
+        uint16_t refs;
+        bool cached;
+        uint32_t last_used;
+    };
+
+    std::vector<Entry> entries;
+
+    size_t budget      = ICON_CACHE_BUDGET;
+    size_t usage       = 0;
+    uint32_t use_clock = 0;
+
+    // Statistics
+    uint32_t hits      = 0;
+    uint32_t misses    = 0;
+    uint32_t evictions = 0;
+    uint32_t overflows = 0;
+
+    IconCache() = default;
+
+    void destroy(size_t index) {
+        Entry& entry = entries[index];
+        if (entry.cached)
+            usage -= entry.size;
+        lv_draw_buf_destroy(entry.buf);
+        entries.erase(entries.begin() + index);
+    }
+
+    // Evict least recently used, unreferenced entries until `needed` bytes fit the budget
+    bool make_room(size_t needed) {
+        while (usage + needed > budget) {
+            size_t victim = entries.size();
+            for (size_t i = 0; i < entries.size(); i++) {
+                if (entries[i].refs > 0 || !entries[i].cached)
+                    continue;
+                if (victim == entries.size() || entries[i].last_used < entries[victim].last_used)
+                    victim = i;
+            }
+            if (victim == entries.size())
+                return false;
+
+            destroy(victim);
+            evictions++;
+        }
+        return true;
+    }
+
+public:
+    IconCache(const IconCache&) = delete;
+    void operator=(const IconCache&) = delete;
+
+    static IconCache& getInstance() {
+        static IconCache instance;
+        return instance;
+    }
+
+    /**
+     * @brief Get a bitmap for the icon, rasterizing it on a miss
+     * @return draw buffer usable as lv_image source, nullptr on failure.
+     *         Must be returned with Release() when no longer displayed.
+     */
+    const lv_draw_buf_t* Acquire(const char* text, const lv_font_t* font, lv_color_t color) {
+        if (text == nullptr || font == nullptr)
+            return nullptr;
+
+        uint32_t color_key = lv_color_to_u32(color);
+        for (Entry& entry : entries) {
+            if (entry.font == font && entry.color == color_key && entry.text == text) {
+                entry.refs++;
+                entry.last_used = ++use_clock;
+                hits++;
+                return entry.buf;
+            }
+        }
+
+        misses++;
+        lv_draw_buf_t* buf = rasterize_text(text, font, color);
+        if (buf == nullptr)
+            return nullptr;
+
+        size_t size = buf->data_size;
+        bool cached = make_room(size);
+        if (cached)
+            usage += size;
+        else
+            overflows++;
+
+        entries.push_back({text, font, color_key, buf, size, 1, cached, ++use_clock});
+
+        ICON_CACHE_DEBUG_PRINTLN("[IconCache] Miss: " << size << " B, usage " << usage << "/" << budget
+                                 << " B, hits " << hits << ", misses " << misses);
+        return buf;
+    }
+
+    /**
+     * @brief Return a bitmap obtained from Acquire()
+     */
+    void Release(const lv_draw_buf_t* buf) {
+        if (buf == nullptr)
+            return;
+
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (entries[i].buf != buf)
+                continue;
+            if (entries[i].refs > 0)
+                entries[i].refs--;
+            if (entries[i].refs == 0 && !entries[i].cached)
+                destroy(i);
+            return;
+        }
+    }
+
+    /**
+     * @brief Change the RAM budget, evicting unused entries if necessary
+     */
+    void SetBudget(size_t bytes) {
+        budget = bytes;
+        make_room(0);
+    }
+
+    size_t GetBudget(void) { return budget; }
+    size_t GetUsage(void) { return usage; }
+    size_t GetEntryCount(void) { return entries.size(); }
+    uint32_t GetHits(void) { return hits; }
+    uint32_t GetMisses(void) { return misses; }
+    uint32_t GetEvictions(void) { return evictions; }
+    uint32_t GetOverflows(void) { return overflows; }
+
+    void ResetStats(void) {
+        hits = misses = evictions = overflows = 0;
+    }
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "lvgl.h"
+
+// Width of the ARGB8888 tile used to build A8 strips (transient RAM = tile * height * 4)
+#define TEXT_RASTER_TILE_WIDTH  128
+
+/**
+ * @brief Draw `text` into `buf` through an off-screen canvas
+ * @param area text area relative to the buffer, may extend beyond it (clipped)
+ */
+inline void draw_text_to_buf(lv_draw_buf_t* buf, const char* text, const lv_font_t* font,
+                             lv_color_t color, lv_text_align_t align, const lv_area_t* area) {
+    // Off-screen canvas, only used as a render target
+    lv_obj_t* canvas = lv_canvas_create(lv_layer_sys());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, buf);
+
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.color = color;
+    dsc.font  = font;
+    dsc.text  = text;
+    dsc.align = align;
+
+    lv_draw_label(&layer, &dsc, area);
+    lv_canvas_finish_layer(canvas, &layer);
+
+    lv_obj_delete(canvas);
+}
+
+/**
+ * @brief Rasterize a text into a new ARGB8888 draw buffer
+ * @param text UTF-8 text (glyph or string) to render
+ * @param font font used for rendering
+ * @param color text color baked into the bitmap
+ * @return draw buffer owned by the caller or nullptr on failure
+ */
+inline lv_draw_buf_t* rasterize_text(const char* text, const lv_font_t* font, lv_color_t color) {
+    if (text == nullptr || font == nullptr)
+        return nullptr;
+
+    lv_point_t size;
+    lv_text_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    if (size.x <= 0 || size.y <= 0)
+        return nullptr;
+
+    lv_draw_buf_t* buf = lv_draw_buf_create(size.x, size.y, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if (buf == nullptr)
+        return nullptr;
+    lv_draw_buf_clear(buf, NULL);
+
+    lv_area_t area = {0, 0, size.x - 1, size.y - 1};
+    draw_text_to_buf(buf, text, font, color, LV_TEXT_ALIGN_LEFT, &area);
+    return buf;
+}
+
+/**
+ * @brief Rasterize a text into a new A8 (coverage only) draw buffer
+ *
+ * The text is rendered in TEXT_RASTER_TILE_WIDTH wide ARGB8888 tiles whose
+ * alpha is copied into the strip, so long texts don't need a full size
+ * ARGB8888 buffer. Draw the result with `image_recolor` to give it a color.
+ *
+ * @param padding transparent columns appended after the text
+ * @param text_width output, width of the text without padding
+ * @return draw buffer owned by the caller or nullptr on failure
+ */
+inline lv_draw_buf_t* rasterize_text_a8(const char* text, const lv_font_t* font, lv_text_align_t align,
+                                        int32_t padding = 0, int32_t* text_width = nullptr) {
+    if (text == nullptr || font == nullptr)
+        return nullptr;
+
+    lv_point_t size;
+    lv_text_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    if (size.x <= 0 || size.y <= 0)
+        return nullptr;
+    if (text_width != nullptr)
+        *text_width = size.x;
+
+    lv_draw_buf_t* strip = lv_draw_buf_create(size.x + padding, size.y, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if (strip == nullptr)
+        return nullptr;
+    lv_draw_buf_clear(strip, NULL);
+
+    int32_t tile_width = LV_MIN(size.x, TEXT_RASTER_TILE_WIDTH);
+    lv_draw_buf_t* tile = lv_draw_buf_create(tile_width, size.y, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if (tile == nullptr) {
+        lv_draw_buf_destroy(strip);
+        return nullptr;
+    }
+
+    for (int32_t x0 = 0; x0 < size.x; x0 += tile_width) {
+        lv_draw_buf_clear(tile, NULL);
+
+        // Shift the text so that only this tile's columns land in the buffer
+        lv_area_t area = {-x0, 0, size.x - 1 - x0, size.y - 1};
+        draw_text_to_buf(tile, text, font, lv_color_white(), align, &area);
+
+        int32_t columns = LV_MIN(tile_width, size.x - x0);
+        for (int32_t y = 0; y < size.y; y++) {
+            const uint8_t* src = tile->data + y * tile->header.stride;
+            uint8_t* dst = strip->data + y * strip->header.stride + x0;
+            for (int32_t x = 0; x < columns; x++) {
+                dst[x] = src[x * 4 + 3];
+            }
+        }
+    }
+
+    lv_draw_buf_destroy(tile);
+    return strip;
+}
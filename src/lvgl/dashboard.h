@@ -6,6 +6,9 @@
 #include "styles/themes.h"
 #include "widgets/popup.h"
 #include "widgets/icon_button.h"
+#include "widgets/cached_icon.h"
+#include "widgets/arc_track.h"
+#include "widgets/scroll_label.h"
 #include "../notify/CommandQueue.h"
 #include <string>
 
@@ -19,16 +22,18 @@ private:
     // Screen components
     bool isArcPressed = false;
     lv_obj_t* arc;
+    ArcTrack* arcTrack = nullptr;
+    int arcDuration = -1;
     lv_obj_t* batteryIcon;
 
     // Labels
-    lv_obj_t* trackTitle;
-    lv_obj_t* trackArtist;
+    ScrollLabel* trackTitle;
+    ScrollLabel* trackArtist;
     lv_obj_t* trackSamplerate;
     lv_obj_t* trackSeek;
 
     // Player Icons
-    lv_obj_t* playerIcon;
+    CachedIcon* playerIcon;
     IconButton* playIcon;
     IconButton* nextIcon;
     IconButton* prevIcon;
@@ -44,13 +49,20 @@ private:
         lv_arc_set_value(arc, v);
     }
     void UpdateArc(int value) {
-        static int target_arc_value = value;
         int32_t current_value = lv_arc_get_value(this->arc);
 
         if (current_value == value)
             return;
 
         #if ARC_ANIMATION_ENABLE
+            lv_anim_delete(this->arc, (lv_anim_exec_xcb_t)arc_anim_exec_cb);
+
+            // Regular seek ticks only move the indicator by a few degrees - no need to animate
+            if (LV_ABS(value - current_value) <= ARC_ANIMATION_MIN_STEP) {
+                lv_arc_set_value(this->arc, value);
+                return;
+            }
+
             lv_anim_t a;
             lv_anim_init(&a);
             lv_anim_set_var(&a, this->arc);
@@ -64,6 +76,27 @@ private:
         #endif
     }
 
+    // Change the arc range only when the track duration changes
+    void UpdateArcRange(int duration) {
+        if (duration <= 0)
+            duration = 1;
+        if (duration == this->arcDuration)
+            return;
+        this->arcDuration = duration;
+        lv_arc_set_range(this->arc, 0, duration);
+    }
+
+    #if ARC_VERBOSE == true
+        uint32_t invalidatedPixels = 0;
+
+        static void OnDisplayInvalidate(lv_event_t * e) {
+            Dashboard * dashboard = static_cast<Dashboard*>(lv_event_get_user_data(e));
+            const lv_area_t * area = static_cast<const lv_area_t*>(lv_event_get_param(e));
+            if (dashboard == nullptr || area == nullptr) return;
+            dashboard->invalidatedPixels += lv_area_get_size(area);
+        }
+    #endif
+
     static void OnArcTouch(lv_event_t * e) {
         Dashboard * dashboard = static_cast<Dashboard*>(lv_event_get_user_data(e));
         if (dashboard == nullptr) return;
@@ -155,6 +188,14 @@ public:
         lv_obj_add_event_cb(arc, OnArcTouch, LV_EVENT_PRESSING, this);
         lv_obj_add_event_cb(arc, OnArcTouchLost, LV_EVENT_RELEASED, this);
 
+        // Pre-render the arc background track
+        #if ARC_TRACK_CACHE_ENABLE
+            arcTrack = new ArcTrack(arc, ARC_BG_COLOR);
+        #endif
+        #if ARC_VERBOSE == true
+            lv_display_add_event_cb(lv_obj_get_display(screen), OnDisplayInvalidate, LV_EVENT_INVALIDATE_AREA, this);
+        #endif
+
         // Create battery icon
         batteryIcon = lv_label_create(screen);
         lv_obj_align(batteryIcon, LV_ALIGN_CENTER, 0, -85);
@@ -164,26 +205,24 @@ public:
 
     /* TOP */
         // Create track title label
-        trackTitle = lv_label_create(screen);
-        lv_obj_align(trackTitle, LV_ALIGN_CENTER, 0, -55);
-        lv_obj_set_style_text_color(trackTitle, TEXT_COLOR, LV_PART_MAIN);
-        lv_obj_set_style_text_font(trackTitle, TITLE_FONT, LV_PART_MAIN);
-        lv_obj_set_style_text_align(trackTitle, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-        lv_obj_set_width(trackTitle, 150);
-        lv_label_set_text(trackTitle, "-");
-        lv_label_set_long_mode(trackTitle, LV_LABEL_LONG_SCROLL_CIRCULAR);
-        lv_obj_move_foreground(trackTitle);
+        trackTitle = new ScrollLabel(screen);
+        trackTitle->SetColor(TEXT_COLOR);
+        trackTitle->SetFont(TITLE_FONT);
+        trackTitle->SetTextAlign(LV_TEXT_ALIGN_CENTER);
+        trackTitle->SetWidth(150);
+        trackTitle->SetText("-");
+        trackTitle->Align(LV_ALIGN_CENTER, 0, -55);
+        lv_obj_move_foreground(trackTitle->GetWidget());
 
         // Create track artist label
-        trackArtist = lv_label_create(screen);
-        lv_obj_align(trackArtist, LV_ALIGN_CENTER, 0, -35);
-        lv_obj_set_style_text_color(trackArtist, ACCENT_COLOR, LV_PART_MAIN);
-        lv_obj_set_style_text_font(trackArtist, TITLE_FONT, LV_PART_MAIN);
-        lv_obj_set_style_text_align(trackArtist, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-        lv_obj_set_width(trackArtist, 160);
-        lv_label_set_text(trackArtist, "-");
-        lv_label_set_long_mode(trackArtist, LV_LABEL_LONG_SCROLL_CIRCULAR);
-        lv_obj_move_foreground(trackArtist);
+        trackArtist = new ScrollLabel(screen);
+        trackArtist->SetColor(ACCENT_COLOR);
+        trackArtist->SetFont(TITLE_FONT);
+        trackArtist->SetTextAlign(LV_TEXT_ALIGN_CENTER);
+        trackArtist->SetWidth(160);
+        trackArtist->SetText("-");
+        trackArtist->Align(LV_ALIGN_CENTER, 0, -35);
+        lv_obj_move_foreground(trackArtist->GetWidget());
 
     /* MIDDLE */
         // Create play icon
@@ -241,11 +280,11 @@ public:
         shuffleIcon->Align(LV_ALIGN_CENTER, 60, 80);
 
         // Create player icon (service/format icon)
-        playerIcon = lv_label_create(screen);
-        lv_obj_align(playerIcon, LV_ALIGN_CENTER, 0, 100);
-        lv_obj_set_style_text_color(playerIcon, ACCENT_COLOR, LV_PART_MAIN);
-        lv_obj_set_style_text_font(playerIcon, PLAYER_ICONS, LV_PART_MAIN);
-        lv_label_set_text(playerIcon, LV_SYMBOL_AUDIO);
+        playerIcon = new CachedIcon(screen);
+        playerIcon->SetFont(PLAYER_ICONS);
+        playerIcon->SetColor(ACCENT_COLOR);
+        playerIcon->SetIcon(LV_SYMBOL_AUDIO);
+        lv_obj_align(playerIcon->GetWidget(), LV_ALIGN_CENTER, 0, 100);
 
         // Create popup widget
         popup = new lvgl_popup(screen);
@@ -277,6 +316,25 @@ public:
             delete shuffleIcon;
             shuffleIcon = nullptr;
         }
+        if (playerIcon) {
+            delete playerIcon;
+            playerIcon = nullptr;
+        }
+        if (arcTrack) {
+            delete arcTrack;
+            arcTrack = nullptr;
+        }
+        if (trackTitle) {
+            delete trackTitle;
+            trackTitle = nullptr;
+        }
+        if (trackArtist) {
+            delete trackArtist;
+            trackArtist = nullptr;
+        }
+        #if ARC_VERBOSE == true
+            lv_display_remove_event_cb_with_user_data(lv_obj_get_display(this->screen), OnDisplayInvalidate, this);
+        #endif
         if (this->screen) {
             lv_obj_del(this->screen);
             this->screen = nullptr;
@@ -315,7 +373,7 @@ public:
     void SetArcValue(int value, int max){
         if(this->arc == nullptr)
             return;
-        lv_arc_set_range(this->arc, 0, max);
+        UpdateArcRange(max);
         UpdateArc(value);
     }
 
@@ -347,12 +405,12 @@ public:
     void SetTrackTitle(const char *title){
         if(this->trackTitle == nullptr)
             return;
-        lv_label_set_text(this->trackTitle, title);
+        this->trackTitle->SetText(title);
     }
     void SetTrackArtist(const char *artist){
         if(this->trackArtist == nullptr)
             return;
-        lv_label_set_text(this->trackArtist, artist);
+        this->trackArtist->SetText(artist);
     }
     void SetTrackSamplerate(const char *samplerate){
         if(this->trackSamplerate == nullptr)
@@ -365,15 +423,14 @@ public:
         if(this->trackSeek == nullptr)
             return;
 
-        // Update arc
-        if(!this->isArcPressed)
-            lv_arc_set_value(this->arc, seek);
+        #if ARC_VERBOSE == true
+            this->invalidatedPixels = 0;
+        #endif
 
-        // Only change the arc range
-        if(duration <= 0)
-            lv_arc_set_range(this->arc, 0, 1);
-        else
-            lv_arc_set_range(this->arc, 0, duration);
+        // Update arc - range first, so the value is not clamped to the previous track
+        UpdateArcRange(duration);
+        if(!this->isArcPressed)
+            UpdateArc(seek);
 
         // Update track seek label
         std::string seek_str;
@@ -387,13 +444,17 @@ public:
                     (dur_sec < 10 ? "0" : "") + std::to_string(dur_sec);
 
         lv_label_set_text(this->trackSeek, seek_str.c_str());
+
+        #if ARC_VERBOSE == true
+            DEBUG_PRINTLN("[Dashboard] Seek tick invalidated " << this->invalidatedPixels << " px");
+        #endif
     }
 
     // Player Icons
     void SetPlayerIcon(const char *icon){
         if(this->playerIcon == nullptr)
             return;
-        lv_label_set_text(this->playerIcon, icon);
+        this->playerIcon->SetIcon(icon);
     }
     void SetStatus(bool isPlaying){
         if(this->playIcon == nullptr)
@@ -428,10 +489,10 @@ public:
             lv_obj_set_style_arc_color(this->arc, color, LV_PART_INDICATOR);
 
         if(this->trackArtist != nullptr)
-            lv_obj_set_style_text_color(this->trackArtist, color, LV_PART_MAIN);
+            this->trackArtist->SetColor(color);
 
         if(this->playerIcon != nullptr)
-            lv_obj_set_style_text_color(this->playerIcon, color, LV_PART_MAIN);
+            this->playerIcon->SetColor(color);
 
         // Icon pressed color
         if(this->playIcon != nullptr)
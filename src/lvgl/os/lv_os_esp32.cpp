@@ -0,0 +1,108 @@
+#include "lvgl.h"
+
+#if LV_USE_OS == LV_OS_CUSTOM
+
+#include "display_config.h"
+
+// Name parameter of lv_thread_init() since v9.3
+#define LV_THREAD_HAS_NAME (LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 3))
+
+extern "C" {
+
+static void thread_entry(void* param) {
+    lv_thread_t* thread = static_cast<lv_thread_t*>(param);
+    thread->callback(thread->user_data);
+    vTaskDelete(NULL);
+}
+
+static lv_result_t thread_create(lv_thread_t* thread, const char* name, void (*callback)(void*),
+                                 size_t stack_size, void* user_data) {
+    thread->callback  = callback;
+    thread->user_data = user_data;
+
+    // The only LVGL threads are the draw units - LVGL's priority is replaced by the configured one.
+    // ESP-IDF takes the stack depth in bytes.
+    BaseType_t ret = xTaskCreatePinnedToCore(thread_entry, name, stack_size, thread,
+                                             DRAW_THREAD_PRIORITY, &thread->task, DRAW_THREAD_CORE);
+    return ret == pdPASS ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+#if LV_THREAD_HAS_NAME
+lv_result_t lv_thread_init(lv_thread_t* thread, const char* const name, lv_thread_prio_t prio,
+                           void (*callback)(void*), size_t stack_size, void* user_data) {
+    (void)prio;
+    return thread_create(thread, name, callback, stack_size, user_data);
+}
+#else
+lv_result_t lv_thread_init(lv_thread_t* thread, lv_thread_prio_t prio, void (*callback)(void*),
+                           size_t stack_size, void* user_data) {
+    (void)prio;
+    return thread_create(thread, "lvglDraw", callback, stack_size, user_data);
+}
+#endif
+
+lv_result_t lv_thread_delete(lv_thread_t* thread) {
+    vTaskDelete(thread->task);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_mutex_init(lv_mutex_t* mutex) {
+    mutex->mutex = xSemaphoreCreateRecursiveMutex();
+    return mutex->mutex != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_lock(lv_mutex_t* mutex) {
+    return xSemaphoreTakeRecursive(mutex->mutex, portMAX_DELAY) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_lock_isr(lv_mutex_t* mutex) {
+    BaseType_t woken = pdFALSE;
+    BaseType_t ret = xSemaphoreTakeFromISR(mutex->mutex, &woken);
+    portYIELD_FROM_ISR(woken);
+    return ret == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_unlock(lv_mutex_t* mutex) {
+    return xSemaphoreGiveRecursive(mutex->mutex) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_mutex_delete(lv_mutex_t* mutex) {
+    vSemaphoreDelete(mutex->mutex);
+    mutex->mutex = NULL;
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_init(lv_thread_sync_t* sync) {
+    sync->signal = xSemaphoreCreateBinary();
+    return sync->signal != NULL ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_thread_sync_wait(lv_thread_sync_t* sync) {
+    return xSemaphoreTake(sync->signal, portMAX_DELAY) == pdTRUE ? LV_RESULT_OK : LV_RESULT_INVALID;
+}
+
+lv_result_t lv_thread_sync_signal(lv_thread_sync_t* sync) {
+    xSemaphoreGive(sync->signal);     // Already given - the waiter has not taken it yet, nothing lost
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_signal_isr(lv_thread_sync_t* sync) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(sync->signal, &woken);
+    portYIELD_FROM_ISR(woken);
+    return LV_RESULT_OK;
+}
+
+lv_result_t lv_thread_sync_delete(lv_thread_sync_t* sync) {
+    vSemaphoreDelete(sync->signal);
+    sync->signal = NULL;
+    return LV_RESULT_OK;
+}
+
+uint32_t lv_os_get_idle_percent(void) {
+    return lv_timer_get_idle();
+}
+
+}   // extern "C"
+
+#endif // LV_USE_OS == LV_OS_CUSTOM
@@ -21,6 +21,17 @@
     // Animations
     #define ARC_ANIMATION_ENABLE    1
     #define ARC_ANIMATION_DURATION  250
+    #define ARC_ANIMATION_MIN_STEP  2       // [s] smaller seek changes are applied without animation
+
+    // Cache the arc background track as an A8 image (radius^2 * 4 bytes)
+    #define ARC_TRACK_CACHE_ENABLE  1
+
+    // Scrolling labels
+    #define SCROLL_LABEL_SPEED      30      // [px/s]
+    #define SCROLL_LABEL_GAP        40      // [px] space between the end and the start of a scrolling text
+
+    // Icon cache - RAM budget for pre-rasterized icon bitmaps (ARGB8888)
+    #define ICON_CACHE_BUDGET       (32 * 1024)
 
 
 /* POPUP */
@@ -39,4 +50,6 @@
 
     // Animations
     #define POPUP_ANIMATION_ENABLE
-    #define POPUP_ANIMATION_DURATION 350
\ No newline at end of file
+    #define POPUP_ANIMATION_DURATION 350
+    #define POPUP_FRAME_BUDGET      33      // [ms] slower frames finish the animation immediately
+    #define POPUP_FALLBACK_HOLD     5000    // [ms] animations stay disabled after a slow frame
\ No newline at end of file
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "lvgl.h"
+#include "../styles/styles.h"
+#include <math.h>
+
+/**
+ * @brief Pre-rendered background track of an lv_arc
+ *
+ * The arc's MAIN part (background track) is rasterized once into an A8 mask
+ * and shown as a recolored image behind the arc. The arc itself then only
+ * draws the indicator and the knob, so seek updates blit the cached track
+ * instead of re-rendering the anti-aliased background arc.
+ */
+class ArcTrack {
+private:
+    lv_obj_t* arc           = nullptr;
+    lv_obj_t* image         = nullptr;
+    lv_draw_buf_t* buf      = nullptr;
+
+    static inline float clamp01(float v) {
+        return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    }
+
+    // Angular distance from `from` to `to` going clockwise, in [0, 360)
+    static inline float angle_span(float from, float to) {
+        float span = fmodf(to - from, 360.0f);
+        return span < 0.0f ? span + 360.0f : span;
+    }
+
+    /**
+     * @brief Rasterize the arc background with the same geometry lv_arc uses
+     */
+    bool render(void) {
+        lv_obj_update_layout(arc);
+
+        // Same center and radius calculation as lv_arc
+        int32_t pad_left   = lv_obj_get_style_pad_left(arc, LV_PART_MAIN);
+        int32_t pad_right  = lv_obj_get_style_pad_right(arc, LV_PART_MAIN);
+        int32_t pad_top    = lv_obj_get_style_pad_top(arc, LV_PART_MAIN);
+        int32_t pad_bottom = lv_obj_get_style_pad_bottom(arc, LV_PART_MAIN);
+        int32_t radius = LV_MIN(lv_obj_get_width(arc) - pad_left - pad_right,
+                                lv_obj_get_height(arc) - pad_top - pad_bottom) / 2;
+        int32_t width  = LV_MIN(lv_obj_get_style_arc_width(arc, LV_PART_MAIN), radius);
+        bool rounded   = lv_obj_get_style_arc_rounded(arc, LV_PART_MAIN);
+
+        int32_t rotation = lv_arc_get_rotation(arc);
+        float start = (float)(lv_arc_get_bg_angle_start(arc) + rotation);
+        float end   = (float)(lv_arc_get_bg_angle_end(arc) + rotation);
+        float span  = angle_span(start, end);
+
+        int32_t size = radius * 2;
+        buf = lv_draw_buf_create(size, size, LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+        if (buf == nullptr)
+            return false;
+
+        float outer = (float)radius;
+        float inner = (float)(radius - width);
+        float mid   = (outer + inner) / 2.0f;
+        float cap_r = (float)width / 2.0f;
+
+        // Cap centers at both ends of the track
+        float start_rad = start * (float)M_PI / 180.0f;
+        float end_rad   = end * (float)M_PI / 180.0f;
+        float cap_sx = mid * cosf(start_rad), cap_sy = mid * sinf(start_rad);
+        float cap_ex = mid * cosf(end_rad),   cap_ey = mid * sinf(end_rad);
+
+        for (int32_t y = 0; y < size; y++) {
+            uint8_t* row = buf->data + y * buf->header.stride;
+            float dy = (float)y + 0.5f - outer;
+
+            for (int32_t x = 0; x < size; x++) {
+                float dx = (float)x + 0.5f - outer;
+                float dist = sqrtf(dx * dx + dy * dy);
+                float coverage = 0.0f;
+
+                // Ring body, limited to the track angles
+                if (dist > inner - 1.0f && dist < outer + 1.0f) {
+                    float angle = atan2f(dy, dx) * 180.0f / (float)M_PI;
+                    if (angle_span(start, angle) <= span)
+                        coverage = clamp01(outer - dist + 0.5f) * clamp01(dist - inner + 0.5f);
+                }
+
+                // Rounded caps
+                if (rounded && coverage < 1.0f) {
+                    float ds = sqrtf((dx - cap_sx) * (dx - cap_sx) + (dy - cap_sy) * (dy - cap_sy));
+                    float de = sqrtf((dx - cap_ex) * (dx - cap_ex) + (dy - cap_ey) * (dy - cap_ey));
+                    coverage = LV_MAX(coverage, clamp01(cap_r - LV_MIN(ds, de) + 0.5f));
+                }
+
+                row[x] = (uint8_t)(coverage * 255.0f + 0.5f);
+            }
+        }
+
+        lv_image_set_src(image, buf);
+        lv_obj_set_pos(image, lv_obj_get_x(arc) + pad_left, lv_obj_get_y(arc) + pad_top);
+        return true;
+    }
+
+public:
+    ArcTrack(lv_obj_t* arc, lv_color_t color) : arc(arc) {
+        if (arc == nullptr)
+            return;
+
+        image = lv_image_create(lv_obj_get_parent(arc));
+        lv_obj_remove_flag(image, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_image_recolor(image, color, LV_PART_MAIN);
+        lv_obj_set_style_image_recolor_opa(image, LV_OPA_COVER, LV_PART_MAIN);
+
+        // Keep the track right behind the arc
+        lv_obj_move_to_index(image, lv_obj_get_index(arc));
+
+        if (render()) {
+            // The arc no longer draws its own background
+            lv_obj_set_style_arc_opa(arc, LV_OPA_TRANSP, LV_PART_MAIN);
+        }
+        else {
+            lv_obj_del(image);
+            image = nullptr;
+        }
+    }
+
+    ~ArcTrack() {
+        if (image != nullptr) {
+            lv_obj_del(image);
+            image = nullptr;
+        }
+        if (buf != nullptr) {
+            lv_draw_buf_destroy(buf);
+            buf = nullptr;
+        }
+    }
+
+    bool IsCached(void) { return image != nullptr; }
+    size_t GetSize(void) { return buf != nullptr ? buf->data_size : 0; }
+};
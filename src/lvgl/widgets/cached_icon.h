@@ -0,0 +1,68 @@
+#pragma once
+
+#include "lvgl.h"
+#include "../styles/styles.h"
+#include "../cache/icon_cache.h"
+#include <string>
+
+/**
+ * @brief Icon drawn from IconCache bitmaps instead of re-rasterizing font glyphs
+ */
+class CachedIcon {
+private:
+    lv_obj_t* image;
+
+    std::string text          = "";
+    const lv_font_t* font     = SMALL_ICON_FONT;
+    lv_color_t color          = TEXT_COLOR;
+    const lv_draw_buf_t* buf  = nullptr;
+
+    void refresh(void) {
+        if (image == nullptr)
+            return;
+
+        const lv_draw_buf_t* old_buf = buf;
+        buf = text.empty() ? nullptr : IconCache::getInstance().Acquire(text.c_str(), font, color);
+
+        lv_image_set_src(image, buf);
+        IconCache::getInstance().Release(old_buf);
+    }
+
+public:
+    CachedIcon(lv_obj_t* parent) {
+        image = lv_image_create(parent);
+        lv_obj_remove_flag(image, LV_OBJ_FLAG_CLICKABLE);
+    }
+
+    ~CachedIcon() {
+        if (image != nullptr) {
+            lv_obj_del(image);
+            image = nullptr;
+        }
+        IconCache::getInstance().Release(buf);
+        buf = nullptr;
+    }
+
+    lv_obj_t* GetWidget(void) { return image; }
+
+    void SetFont(const lv_font_t* font) {
+        if (this->font == font)
+            return;
+        this->font = font;
+        refresh();
+    }
+
+    void SetIcon(const char* icon_text) {
+        if (icon_text == nullptr || this->text == icon_text)
+            return;
+        this->text = icon_text;
+        refresh();
+    }
+
+    void SetColor(lv_color_t color) {
+        if (lv_color_eq(this->color, color))
+            return;
+        this->color = color;
+        refresh();
+    }
+};
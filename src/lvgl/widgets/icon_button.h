@@ -2,11 +2,12 @@
 
 #include "lvgl.h"
 #include "../styles/styles.h"
+#include "cached_icon.h"
 
 class IconButton {
 private:
     lv_obj_t* button;
-    lv_obj_t* label;
+    CachedIcon* icon;
 
 public:
     IconButton(lv_obj_t* parent) {
@@ -26,21 +27,24 @@ public:
 
         SetButtonPressedColor(ACCENT_COLOR); // Default color
 
-        // Label
-        label = lv_label_create(button);
-        lv_obj_center(label);
+        // Icon
+        icon = new CachedIcon(button);
+        lv_obj_center(icon->GetWidget());
     }
 
     ~IconButton() {
+        if (icon != nullptr) {
+            delete icon;
+            icon = nullptr;
+        }
         if (button != nullptr) {
             lv_obj_del(button);
             button = nullptr;
-            label = nullptr;
         }
     }
 
     lv_obj_t* GetButton(void) { return button; }
-    lv_obj_t* GetLabel(void) { return label; }
+    CachedIcon* GetIcon(void) { return icon; }
 
     void SetCallback(lv_event_cb_t callback, void* user_data = nullptr) {
         if (button != nullptr) {
@@ -66,20 +70,20 @@ public:
             lv_obj_set_style_radius(button, size / 2, LV_PART_MAIN);
             lv_obj_set_style_radius(button, size / 2, LV_STATE_PRESSED);
         }
-        if (label != nullptr) {
-            lv_obj_set_style_text_font(label, font, LV_PART_MAIN);
+        if (icon != nullptr) {
+            icon->SetFont(font);
         }
     }
 
     void SetIcon(const char* icon_text) {
-        if (label != nullptr) {
-            lv_label_set_text(label, icon_text);
+        if (icon != nullptr) {
+            icon->SetIcon(icon_text);
         }
     }
 
     void SetIconColor(lv_color_t color) {
-        if (label != nullptr) {
-            lv_obj_set_style_text_color(label, color, LV_PART_MAIN);
+        if (icon != nullptr) {
+            icon->SetColor(color);
         }
     }
 };
@@ -1,9 +1,9 @@
 #pragma once
 
 #include "freertos/FreeRTOS.h"
-#include "freertos/timers.h"
 #include "lvgl.h"
 #include "../styles/styles.h"
+#include "scroll_label.h"
 #include <string>
 
 class lvgl_popup {
@@ -19,20 +19,113 @@ private:
 
     lv_obj_t *popup         = nullptr;
     lv_obj_t *title_label   = nullptr;
-    lv_obj_t *content_label = nullptr;
+    ScrollLabel *content_label = nullptr;
+
+    // Pre-rendered popup layer used for animations
+    lv_obj_t *layer_image   = nullptr;
+    lv_draw_buf_t *layer_buf = nullptr;
+    bool animating_in       = false;
+
+    // Frame budget tracking - animations are skipped after a slow frame
+    uint32_t frame_start    = 0;
+    uint32_t slow_frame_time = 0;
+    bool skip_animation     = false;
 
     // Animation callbacks
-    static void anim_popup_cb(void * var, int32_t v) {
-        lv_obj_t * popup = static_cast<lv_obj_t*>(var);
-        lv_obj_set_width(popup, lv_map(v, 0, 100, 0, POPUP_WIDTH));
-        lv_obj_set_height(popup, lv_map(v, 0, 100, 0, POPUP_HEIGHT));
-        lv_obj_set_style_text_opa(popup, lv_map(v, 0, 100, 0, POPUP_OPACITY), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(popup, lv_map(v, 0, 100, 0, POPUP_OPACITY), LV_PART_MAIN);
+    static void anim_layer_cb(void * var, int32_t v) {
+        lvgl_popup *instance = static_cast<lvgl_popup*>(var);
+        lv_image_set_scale(instance->layer_image, lv_map(v, 0, 100, 0, LV_SCALE_NONE));
+        lv_obj_set_style_image_opa(instance->layer_image, lv_map(v, 0, 100, 0, LV_OPA_COVER), LV_PART_MAIN);
     }
 
     static void anim_completed_cb(lv_anim_t * a) {
-        lv_obj_t * popup = static_cast<lv_obj_t*>(a->var);
-        lv_obj_add_flag(popup, LV_OBJ_FLAG_HIDDEN);
+        lvgl_popup *instance = static_cast<lvgl_popup*>(a->var);
+        instance->finish_animation();
+    }
+
+    // Display refresh callback - measure frame time against POPUP_FRAME_BUDGET
+    static void display_refr_cb(lv_event_t * e) {
+        lvgl_popup *instance = static_cast<lvgl_popup*>(lv_event_get_user_data(e));
+        if (instance == nullptr)
+            return;
+
+        if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+            instance->frame_start = lv_tick_get();
+            return;
+        }
+
+        uint32_t frame_time = lv_tick_elaps(instance->frame_start);
+        if (instance->layer_buf != nullptr && frame_time > POPUP_FRAME_BUDGET) {
+            // Too slow to animate - jump to the final state
+            instance->skip_animation = true;
+            instance->slow_frame_time = lv_tick_get();
+            lv_anim_delete(instance, (lv_anim_exec_xcb_t)anim_layer_cb);
+            instance->finish_animation();
+        }
+        else if (instance->skip_animation && lv_tick_elaps(instance->slow_frame_time) > POPUP_FALLBACK_HOLD) {
+            instance->skip_animation = false;
+        }
+    }
+
+    /**
+     * @brief Render the popup once into a layer image
+     * @return true if the layer is ready to be animated
+     */
+    bool capture_layer(void) {
+        release_layer();
+
+        lv_obj_clear_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_update_layout(this->popup);
+        this->layer_buf = lv_snapshot_take(this->popup, LV_COLOR_FORMAT_ARGB8888);
+        if (this->layer_buf == nullptr)
+            return false;
+
+        lv_image_set_src(this->layer_image, this->layer_buf);
+        lv_obj_align_to(this->layer_image, this->popup, LV_ALIGN_CENTER, 0, 0);
+        lv_obj_add_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(this->layer_image, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_move_foreground(this->layer_image);
+        return true;
+    }
+
+    void release_layer(void) {
+        if (this->layer_image != nullptr) {
+            lv_obj_add_flag(this->layer_image, LV_OBJ_FLAG_HIDDEN);
+            lv_image_set_src(this->layer_image, NULL);
+        }
+        if (this->layer_buf != nullptr) {
+            lv_draw_buf_destroy(this->layer_buf);
+            this->layer_buf = nullptr;
+        }
+    }
+
+    void start_animation(bool in) {
+        this->animating_in = in;
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, this);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)anim_layer_cb);
+        lv_anim_set_duration(&a, POPUP_ANIMATION_DURATION);
+        lv_anim_set_path_cb(&a, in ? lv_anim_path_ease_out : lv_anim_path_ease_in);
+        lv_anim_set_values(&a, in ? 0 : 100, in ? 100 : 0);
+        lv_anim_set_completed_cb(&a, anim_completed_cb);
+        lv_anim_start(&a);
+    }
+
+    void stop_animation(void) {
+        if (this->layer_buf == nullptr)
+            return;
+        lv_anim_delete(this, (lv_anim_exec_xcb_t)anim_layer_cb);
+        release_layer();
+    }
+
+    void finish_animation(void) {
+        if (this->layer_buf == nullptr)
+            return;
+        release_layer();
+        if (this->animating_in)
+            lv_obj_clear_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
     }
 
     // Timeout timer callback
@@ -68,12 +161,13 @@ public:
 
         // Create popup container - hidden by default
         this->popup = lv_obj_create(parent);
-        lv_obj_set_size(this->popup, 0, 0);
+        lv_obj_set_size(this->popup, POPUP_WIDTH, POPUP_HEIGHT);
         lv_obj_add_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
         lv_obj_clear_flag(this->popup, LV_OBJ_FLAG_SCROLLABLE);
 
         lv_obj_set_style_bg_color(this->popup, POPUP_BG_COLOR, LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(this->popup, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(this->popup, POPUP_OPACITY, LV_PART_MAIN);
+        lv_obj_set_style_text_opa(this->popup, POPUP_OPACITY, LV_PART_MAIN);
         lv_obj_set_style_border_width(this->popup, 1, LV_PART_MAIN);
         lv_obj_set_style_border_color(this->popup, POPUP_BORDER_COLOR, LV_PART_MAIN);
         lv_obj_set_style_radius(this->popup, 15, LV_PART_MAIN);
@@ -87,18 +181,40 @@ public:
         lv_label_set_text(this->title_label, "");
 
         // Create content label (scrollable)
-        this->content_label = lv_label_create(this->popup);
-        lv_obj_align(this->content_label, LV_ALIGN_CENTER, 0, 15);
-        lv_obj_set_width(this->content_label, POPUP_WIDTH - 20);
-        lv_label_set_long_mode(this->content_label, LV_LABEL_LONG_SCROLL_CIRCULAR);
-        lv_obj_set_style_text_align(this->content_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
-        lv_obj_set_style_text_color(this->content_label, POPUP_TEXT_COLOR, LV_PART_MAIN);
-        lv_obj_set_style_text_font(this->content_label, POPUP_CONTENT_FONT, LV_PART_MAIN);
-        lv_label_set_text(this->content_label, "");
+        this->content_label = new ScrollLabel(this->popup);
+        this->content_label->SetTextAlign(LV_TEXT_ALIGN_CENTER);
+        this->content_label->SetColor(POPUP_TEXT_COLOR);
+        this->content_label->SetOpa(POPUP_OPACITY);
+        this->content_label->SetFont(POPUP_CONTENT_FONT);
+        this->content_label->SetWidth(POPUP_WIDTH - 20);
+        this->content_label->Align(LV_ALIGN_CENTER, 0, 15);
+
+        // Layer image used for the show / hide animation - hidden by default
+        this->layer_image = lv_image_create(parent);
+        lv_obj_add_flag(this->layer_image, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_remove_flag(this->layer_image, LV_OBJ_FLAG_CLICKABLE);
+
+        #ifdef POPUP_ANIMATION_ENABLE
+            lv_display_add_event_cb(lv_obj_get_display(parent), display_refr_cb, LV_EVENT_REFR_START, this);
+            lv_display_add_event_cb(lv_obj_get_display(parent), display_refr_cb, LV_EVENT_REFR_READY, this);
+        #endif
     }
 
     ~lvgl_popup() {
         stop_timeout_timer();
+        stop_animation();
+        #ifdef POPUP_ANIMATION_ENABLE
+            if (this->popup)
+                lv_display_remove_event_cb_with_user_data(lv_obj_get_display(this->popup), display_refr_cb, this);
+        #endif
+        if (this->layer_image) {
+            lv_obj_del(this->layer_image);
+            this->layer_image = nullptr;
+        }
+        if (this->content_label) {
+            delete this->content_label;
+            this->content_label = nullptr;
+        }
         if (this->popup) {
             lv_obj_del(this->popup);
             this->popup = nullptr;
@@ -120,7 +236,7 @@ public:
 
         // Update labels
         lv_label_set_text(this->title_label, title.c_str());
-        lv_label_set_text(this->content_label, content.c_str());
+        this->content_label->SetText(content.c_str());
 
         // If popup is already visible, do not animate
         if(this->is_visible){
@@ -129,23 +245,16 @@ public:
         }
 
         // Show widget
-        lv_obj_clear_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
+        stop_animation();
         lv_obj_align(this->popup, LV_ALIGN_CENTER, 0, 0);
 
         #ifdef POPUP_ANIMATION_ENABLE
-            lv_anim_t a;
-            lv_anim_init(&a);
-            lv_anim_set_var(&a, this->popup);
-            lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)anim_popup_cb);
-            lv_anim_set_duration(&a, POPUP_ANIMATION_DURATION);
-            lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
-            lv_anim_set_values(&a, 0, 100);
-            lv_anim_start(&a);
+            if (!this->skip_animation && capture_layer())
+                start_animation(true);
+            else
+                lv_obj_clear_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
         #else
-            lv_obj_set_width(this->popup, POPUP_WIDTH);
-            lv_obj_set_height(this->popup, POPUP_HEIGHT);
-            lv_obj_set_style_text_opa(this->popup, POPUP_OPACITY, LV_PART_MAIN);
-            lv_obj_set_style_bg_opa(this->popup, POPUP_OPACITY, LV_PART_MAIN);
+            lv_obj_clear_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
         #endif
 
         this->is_visible = true;
@@ -156,21 +265,14 @@ public:
         if(this->popup == nullptr || !is_visible)
             return;
 
+        stop_animation();
+
         #ifdef POPUP_ANIMATION_ENABLE
-            lv_anim_t a;
-            lv_anim_init(&a);
-            lv_anim_set_var(&a, this->popup);
-            lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)anim_popup_cb);
-            lv_anim_set_duration(&a, POPUP_ANIMATION_DURATION);
-            lv_anim_set_path_cb(&a, lv_anim_path_ease_in);
-            lv_anim_set_values(&a, 100, 0);
-            lv_anim_set_completed_cb(&a, anim_completed_cb);
-            lv_anim_start(&a);
+            if (!this->skip_animation && capture_layer())
+                start_animation(false);
+            else
+                lv_obj_add_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
         #else
-            lv_obj_set_width(this->popup, POPUP_WIDTH);
-            lv_obj_set_height(this->popup, POPUP_HEIGHT);
-            lv_obj_set_style_text_opa(this->popup, LV_OPA_TRANSP, LV_PART_MAIN);
-            lv_obj_set_style_bg_opa(this->popup, LV_OPA_TRANSP, LV_PART_MAIN);
             lv_obj_add_flag(this->popup, LV_OBJ_FLAG_HIDDEN);
         #endif
 
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "lvgl.h"
+#include "../styles/styles.h"
+#include "../cache/text_raster.h"
+#include <string>
+
+/**
+ * @brief Single text label with circular scrolling for long texts
+ *
+ * The text is rasterized once into an A8 strip (text + gap) whenever it
+ * changes. Scrolling moves the offset of a tiled lv_image over that strip,
+ * so scroll steps only blit cached pixels instead of re-shaping and
+ * re-rasterizing the glyphs like LV_LABEL_LONG_SCROLL_CIRCULAR does.
+ */
+class ScrollLabel {
+private:
+    lv_obj_t* image;
+    lv_draw_buf_t* strip      = nullptr;
+
+    std::string text          = "";
+    const lv_font_t* font     = LABEL_FONT;
+    lv_text_align_t align     = LV_TEXT_ALIGN_CENTER;
+    int32_t width             = 0;
+    int32_t text_width        = 0;
+
+    static void anim_offset_cb(void * var, int32_t v) {
+        lv_image_set_offset_x(static_cast<lv_obj_t*>(var), -v);
+    }
+
+    void stop_scroll(void) {
+        lv_anim_delete(image, (lv_anim_exec_xcb_t)anim_offset_cb);
+        lv_image_set_offset_x(image, 0);
+    }
+
+    void render(void) {
+        stop_scroll();
+        lv_image_set_src(image, NULL);
+        if (strip != nullptr) {
+            lv_draw_buf_destroy(strip);
+            strip = nullptr;
+        }
+
+        if (text.empty())
+            return;
+
+        // Only a scrolling text gets the gap - a fitting strip is aligned as a whole
+        lv_point_t size;
+        lv_text_get_size(&size, text.c_str(), font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+        bool scroll = width > 0 && size.x > width;
+
+        strip = rasterize_text_a8(text.c_str(), font, align, scroll ? SCROLL_LABEL_GAP : 0, &text_width);
+        if (strip == nullptr)
+            return;
+
+        lv_image_set_src(image, strip);
+
+        // Fits - show the text aligned
+        if (!scroll) {
+            lv_image_set_inner_align(image, align == LV_TEXT_ALIGN_LEFT ? LV_IMAGE_ALIGN_LEFT_MID :
+                                            align == LV_TEXT_ALIGN_RIGHT ? LV_IMAGE_ALIGN_RIGHT_MID :
+                                                                           LV_IMAGE_ALIGN_CENTER);
+            lv_obj_set_size(image, width > 0 ? width : text_width, strip->header.h);
+            return;
+        }
+
+        // Too long - scroll the tiled strip by its full width for a seamless loop
+        int32_t period = strip->header.w;
+        lv_image_set_inner_align(image, LV_IMAGE_ALIGN_TILE);
+        lv_obj_set_size(image, width, strip->header.h);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_var(&a, image);
+        lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)anim_offset_cb);
+        lv_anim_set_values(&a, 0, period);
+        lv_anim_set_duration(&a, period * 1000 / SCROLL_LABEL_SPEED);
+        lv_anim_set_repeat_count(&a, LV_ANIM_REPEAT_INFINITE);
+        lv_anim_set_path_cb(&a, lv_anim_path_linear);
+        lv_anim_start(&a);
+    }
+
+public:
+    ScrollLabel(lv_obj_t* parent) {
+        image = lv_image_create(parent);
+        lv_obj_remove_flag(image, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_image_recolor_opa(image, LV_OPA_COVER, LV_PART_MAIN);
+        SetColor(TEXT_COLOR);
+    }
+
+    ~ScrollLabel() {
+        if (image != nullptr) {
+            stop_scroll();
+            lv_obj_del(image);
+            image = nullptr;
+        }
+        if (strip != nullptr) {
+            lv_draw_buf_destroy(strip);
+            strip = nullptr;
+        }
+    }
+
+    lv_obj_t* GetWidget(void) { return image; }
+
+    void Align(lv_align_t align, int x_ofs = 0, int y_ofs = 0) {
+        lv_obj_align(image, align, x_ofs, y_ofs);
+    }
+
+    void SetFont(const lv_font_t* font) {
+        if (this->font == font)
+            return;
+        this->font = font;
+        render();
+    }
+
+    void SetTextAlign(lv_text_align_t align) {
+        if (this->align == align)
+            return;
+        this->align = align;
+        render();
+    }
+
+    // Visible width, longer texts scroll
+    void SetWidth(int32_t width) {
+        if (this->width == width)
+            return;
+        this->width = width;
+        render();
+    }
+
+    // Recolor only - the cached strip is kept
+    void SetColor(lv_color_t color) {
+        lv_obj_set_style_image_recolor(image, color, LV_PART_MAIN);
+    }
+
+    void SetOpa(lv_opa_t opa) {
+        lv_obj_set_style_image_opa(image, opa, LV_PART_MAIN);
+    }
+
+    // Rasterizes only when the text actually changes
+    void SetText(const char* text) {
+        if (text == nullptr || this->text == text)
+            return;
+        this->text = text;
+        render();
+    }
+};
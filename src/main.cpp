@@ -7,8 +7,6 @@ void setup() {
     board = new BoardHandler();
     board->RunTask();
 
-    vTaskDelay(1000 / portTICK_PERIOD_MS);
-
     wifi = new WiFiHandler();
     wifi->RunTask();
 }
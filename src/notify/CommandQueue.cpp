@@ -1,4 +1,6 @@
 #include "CommandQueue.h"
+#include "LatencyTracer.h"
+#include "Metrics.h"
 #include "dev_tools.h"
 #include <functional>
 #include <stdlib.h>
@@ -39,6 +41,7 @@ VolumioCommand* CommandQueue::createCommandCopy(const VolumioCommand& cmd) {
     if (copy != nullptr) {
         copy->type = cmd.type;
         copy->value = cmd.value;
+        copy->trace_id = cmd.trace_id;
     }
     return copy;
 }
@@ -55,11 +58,22 @@ bool CommandQueue::postCommand(const VolumioCommand& cmd) {
         return false;
     }
 
+    // Stamped before the send - the consumer owns the command once it is queued
+    uint32_t trace_id = 0;
+    if (cmdPtr->trace_id == 0 && cmdPtr->type != VolumioCommandType::TOGGLE_WIFI_MODE
+        && cmdPtr->type != VolumioCommandType::SELECT_PLAYER && cmdPtr->type != VolumioCommandType::POLL_PERIOD) {
+        trace_id = LatencyTracer::getInstance().begin((uint8_t)cmdPtr->type);
+        cmdPtr->trace_id = trace_id;
+    }
+
     // Queue the pointer (non-blocking)
     BaseType_t result = xQueueSend(commandQueue, &cmdPtr, 0);
 
     if (result != pdTRUE) {
         DEBUG_PRINTLN("[CommandQueue] Queue full, command dropped");
+        Metrics::getInstance().drop(MetricQueue::COMMAND);
+        // Left open, a later command's stages would complete it
+        LatencyTracer::getInstance().cancel(trace_id);
         delete cmdPtr;
         return false;
     }
@@ -80,6 +94,7 @@ bool CommandQueue::getNextCommand(VolumioCommand& cmd) {
             // Copy command data
             cmd.type = cmdPtr->type;
             cmd.value = cmdPtr->value;
+            cmd.trace_id = cmdPtr->trace_id;
 
             // Free the heap-allocated command
             delete cmdPtr;
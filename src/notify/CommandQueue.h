@@ -18,7 +18,11 @@ enum class VolumioCommandType {
     PREV,
     SEEK,
     RANDOM,
-    REPEAT
+    REPEAT,
+    VOLUME,     // value > 0 volume up, value < 0 volume down
+    TOGGLE_WIFI_MODE,   // Handled by WiFiHandler - switch between STA and AP mode
+    SELECT_PLAYER,      // Handled by WiFiHandler - value = player index, -1 next player
+    POLL_PERIOD         // Handled by PlayerManager - value = selected player's poll period [ms], 0 = default
 };
 
 /**
@@ -27,6 +31,7 @@ enum class VolumioCommandType {
 struct VolumioCommand {
     VolumioCommandType type;
     int value;  // Used for volume, seek, random, repeat values
+    uint32_t trace_id = 0;  // LatencyTracer id, assigned by postCommand()
 };
 
 /**
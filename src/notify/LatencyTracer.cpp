@@ -0,0 +1,169 @@
+#include "LatencyTracer.h"
+#include "dev_tools.h"
+#include <algorithm>
+
+LatencyTracer* LatencyTracer::instance = nullptr;
+
+LatencyTracer::LatencyTracer() { }
+LatencyTracer::~LatencyTracer() { }
+
+LatencyTracer& LatencyTracer::getInstance() {
+    if (instance == nullptr) {
+        instance = new LatencyTracer();
+    }
+    return *instance;
+}
+
+const char* LatencyTracer::stageName(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::INPUT:     return "total";
+        case TraceStage::DEQUEUED:  return "queue";
+        case TraceStage::ACKED:     return "command";
+        case TraceStage::FETCHED:   return "fetch";
+        case TraceStage::DISPLAYED: return "display";
+        default:                    return "unknown";
+    }
+}
+
+uint32_t LatencyTracer::begin(uint8_t type) {
+    std::lock_guard<std::mutex> guard(lock);
+    TickType_t now = xTaskGetTickCount();
+
+    // Reuse a free or timed out slot, otherwise the oldest trace
+    Trace* slot = &traces[0];
+    for (Trace& trace : traces) {
+        if (trace.id == 0 || now - trace.stamp[(size_t)TraceStage::INPUT] > pdMS_TO_TICKS(TIMEOUT_MS)) {
+            slot = &trace;
+            break;
+        }
+        if (trace.id < slot->id) {
+            slot = &trace;
+        }
+    }
+    if (slot->id != 0) {
+        dropped++;
+    }
+
+    uint32_t id = next_id++;
+    if (next_id == 0) next_id = 1;
+
+    *slot = {};
+    slot->id = id;
+    slot->type = type;
+    slot->stamp[(size_t)TraceStage::INPUT] = now;
+    slot->reached = 1 << (size_t)TraceStage::INPUT;
+    return id;
+}
+
+void LatencyTracer::mark(uint32_t id, TraceStage stage) {
+    if (id == 0 || stage == TraceStage::INPUT || stage >= TraceStage::COUNT) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    TickType_t now = xTaskGetTickCount();
+    uint8_t previous = 1 << ((size_t)stage - 1);
+    uint8_t current = 1 << (size_t)stage;
+
+    for (Trace& trace : traces) {
+        if (trace.id == 0 || trace.id > id) {
+            continue;
+        }
+        if (!(trace.reached & previous) || (trace.reached & current)) {
+            continue;
+        }
+
+        trace.stamp[(size_t)stage] = now;
+        trace.reached |= current;
+
+        if (stage == TraceStage::DISPLAYED) {
+            complete(trace);
+        }
+    }
+}
+
+void LatencyTracer::cancel(uint32_t id) {
+    if (id == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(lock);
+    for (Trace& trace : traces) {
+        if (trace.id == id) {
+            trace.id = 0;
+        }
+    }
+}
+
+void LatencyTracer::complete(Trace& trace) {
+    for (size_t stage = 1; stage < (size_t)TraceStage::COUNT; stage++) {
+        Samples& s = samples[stage];
+        s.values[s.count % SAMPLES] = pdTICKS_TO_MS(trace.stamp[stage] - trace.stamp[stage - 1]);
+        s.count++;
+    }
+
+    uint32_t total = pdTICKS_TO_MS(trace.stamp[(size_t)TraceStage::DISPLAYED] - trace.stamp[(size_t)TraceStage::INPUT]);
+    Samples& s = samples[(size_t)TraceStage::INPUT];
+    s.values[s.count % SAMPLES] = total;
+    s.count++;
+    completed++;
+
+    #if TRACE_VERBOSE == true
+    DEBUG_PRINTLN("[Trace] #" << trace.id << " type " << (int)trace.type << ": " << total << " ms");
+    #endif
+
+    trace.id = 0;
+}
+
+LatencyTracer::Percentiles LatencyTracer::percentiles(const Samples& samples) {
+    Percentiles result = {samples.count, 0, 0, 0, 0};
+    size_t n = std::min<size_t>(samples.count, SAMPLES);
+    if (n == 0) {
+        return result;
+    }
+
+    uint32_t sorted[SAMPLES];
+    std::copy(samples.values, samples.values + n, sorted);
+    std::sort(sorted, sorted + n);
+
+    result.p50 = sorted[(n - 1) * 50 / 100];
+    result.p90 = sorted[(n - 1) * 90 / 100];
+    result.p99 = sorted[(n - 1) * 99 / 100];
+    result.max = sorted[n - 1];
+    return result;
+}
+
+LatencyTracer::Percentiles LatencyTracer::getPercentiles(TraceStage stage) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (stage >= TraceStage::COUNT) {
+        return {0, 0, 0, 0, 0};
+    }
+    return percentiles(samples[(size_t)stage]);
+}
+
+std::string LatencyTracer::toJson(void) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    size_t in_flight = 0;
+    for (const Trace& trace : traces) {
+        if (trace.id != 0) in_flight++;
+    }
+
+    std::string json = "{\"completed\":" + std::to_string(completed) +
+                       ",\"dropped\":" + std::to_string(dropped) +
+                       ",\"in_flight\":" + std::to_string(in_flight) +
+                       ",\"stages\":{";
+
+    for (size_t stage = 0; stage < (size_t)TraceStage::COUNT; stage++) {
+        Percentiles p = percentiles(samples[stage]);
+        if (stage != 0) json += ",";
+        json += std::string("\"") + stageName((TraceStage)stage) + "\":{" +
+                "\"count\":" + std::to_string(p.count) +
+                ",\"p50\":" + std::to_string(p.p50) +
+                ",\"p90\":" + std::to_string(p.p90) +
+                ",\"p99\":" + std::to_string(p.p99) +
+                ",\"max\":" + std::to_string(p.max) + "}";
+    }
+    json += "}}";
+    return json;
+}
@@ -0,0 +1,115 @@
+#ifndef LATENCY_TRACER_H
+#define LATENCY_TRACER_H
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include <mutex>
+#include <string>
+#include <stdint.h>
+
+/**
+ * @brief Stages a user action passes through until its result is on screen
+ */
+enum class TraceStage : uint8_t {
+    INPUT,      // Command posted by the UI
+    DEQUEUED,   // Picked up by the WiFi task
+    ACKED,      // Volumio answered the command request
+    FETCHED,    // First state fetch after the ack
+    DISPLAYED,  // State applied to the dashboard
+    COUNT
+};
+
+/**
+ * @brief End-to-end latency tracing of user actions
+ *
+ * Every command gets a trace id when it is posted to the CommandQueue. The id
+ * travels with the command and the next Volumio state, and each stage stamps
+ * its time. Completed traces feed per stage sample rings for percentiles.
+ *
+ * Ids are increasing, so marking a stage for an id also marks all older
+ * in-flight traces that reached the previous stage - a state fetched after
+ * command N also contains the effect of the commands before it.
+ */
+class LatencyTracer {
+public:
+    static constexpr size_t MAX_IN_FLIGHT = 8;
+    static constexpr size_t SAMPLES       = 64;   // Kept per stage for percentiles
+    static constexpr uint32_t TIMEOUT_MS  = 10000; // In-flight traces are dropped after this
+
+    struct Percentiles {
+        uint32_t count;
+        uint32_t p50;
+        uint32_t p90;
+        uint32_t p99;
+        uint32_t max;
+    };
+
+private:
+    struct Trace {
+        uint32_t id;
+        uint8_t type;
+        TickType_t stamp[(size_t)TraceStage::COUNT];
+        uint8_t reached;    // Bit mask of stamped stages
+    };
+
+    struct Samples {
+        uint32_t values[SAMPLES];
+        uint32_t count;     // Total samples, the ring keeps the last SAMPLES
+    };
+
+    std::mutex lock;
+    Trace traces[MAX_IN_FLIGHT] = {};
+    // Per stage duration (from the previous stage) and the total at index 0
+    Samples samples[(size_t)TraceStage::COUNT] = {};
+    uint32_t next_id    = 1;
+    uint32_t completed  = 0;
+    uint32_t dropped    = 0;
+
+    static LatencyTracer* instance;
+    LatencyTracer();
+
+    void complete(Trace& trace);
+    static Percentiles percentiles(const Samples& samples);
+
+public:
+    ~LatencyTracer();
+
+    LatencyTracer(const LatencyTracer&) = delete;
+    void operator=(const LatencyTracer&) = delete;
+
+    static LatencyTracer& getInstance();
+
+    /**
+     * @brief Start a trace
+     * @param type command type, kept for the report
+     * @return trace id, never 0
+     */
+    uint32_t begin(uint8_t type);
+
+    /**
+     * @brief Stamp a stage for the trace and older traces waiting for it
+     * @param id trace id, 0 is ignored
+     */
+    void mark(uint32_t id, TraceStage stage);
+
+    /**
+     * @brief Forget a trace whose command never made it into the queue
+     * @param id trace id, 0 is ignored
+     */
+    void cancel(uint32_t id);
+
+    /**
+     * @brief Latency from the previous stage (INPUT = end-to-end total) [ms]
+     */
+    Percentiles getPercentiles(TraceStage stage);
+
+    /**
+     * @brief All stages as JSON for the web server
+     */
+    std::string toJson(void);
+
+    static const char* stageName(TraceStage stage);
+};
+
+#endif // LATENCY_TRACER_H
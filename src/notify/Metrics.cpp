@@ -0,0 +1,163 @@
+#include "Metrics.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+Metrics* Metrics::instance = nullptr;
+
+Metrics::Metrics() { }
+Metrics::~Metrics() { }
+
+Metrics& Metrics::getInstance() {
+    if (instance == nullptr) {
+        instance = new Metrics();
+    }
+    return *instance;
+}
+
+namespace {
+
+struct HistogramInfo {
+    const char* name;
+    const char* help;
+    const char* label;                      // Series label, nullptr for none
+    uint32_t bounds[Metrics::MAX_BUCKETS];  // Upper bounds, 0 terminated
+};
+
+const HistogramInfo histogram_info[(size_t)MetricHistogram::COUNT] = {
+    {"volumio_request_duration_ms", "Volumio HTTP request latency", "request=\"state\"",
+        {10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 0}},
+    {"volumio_request_duration_ms", "Volumio HTTP request latency", "request=\"command\"",
+        {10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 0}},
+    {"display_frame_time_us", "LVGL refresh duration", nullptr,
+        {1000, 2000, 5000, 10000, 16000, 33000, 50000, 100000, 0}},
+};
+
+const char* queue_names[(size_t)MetricQueue::COUNT] = {
+    "command", "track_data", "notification", "wifi_event", "button", "event_stream"
+};
+
+}
+
+size_t metrics_printf(char* buffer, size_t size, size_t len, const char* format, ...) {
+    if (len >= size) {
+        return size;        // Overflowed before
+    }
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + len, size - len, format, args);
+    va_end(args);
+
+    if (written < 0) {
+        return len;
+    }
+    if (len + (size_t)written < size) {
+        return len + (size_t)written;
+    }
+
+    // Cut the partial line - a scraper would read it as a valid sample
+    size_t cut = size - 1;
+    while (cut > 0 && buffer[cut - 1] != '\n') {
+        cut--;
+    }
+    buffer[cut] = '\0';
+    return size;
+}
+
+void Metrics::observe(MetricHistogram histogram, uint32_t value) {
+    if (histogram >= MetricHistogram::COUNT) {
+        return;
+    }
+    const uint32_t* bounds = histogram_info[(size_t)histogram].bounds;
+
+    std::lock_guard<std::mutex> guard(lock);
+    Histogram& h = histograms[(size_t)histogram];
+    for (size_t i = 0; i < MAX_BUCKETS && bounds[i] != 0; i++) {
+        if (value <= bounds[i]) {
+            h.buckets[i]++;
+            break;
+        }
+    }
+    h.count++;
+    h.sum += value;
+}
+
+void Metrics::error(MetricHistogram histogram) {
+    if (histogram >= MetricHistogram::COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    histograms[(size_t)histogram].errors++;
+}
+
+void Metrics::drop(MetricQueue queue) {
+    if (queue >= MetricQueue::COUNT) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    drops[(size_t)queue]++;
+}
+
+void Metrics::registerTask(TaskHandle_t task) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (task_count < METRICS_MAX_TASKS) {
+        tasks[task_count++] = task;
+    }
+}
+
+size_t Metrics::getTasks(TaskHandle_t* out, size_t max) {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t n = task_count < max ? task_count : max;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = tasks[i];
+    }
+    return n;
+}
+
+size_t Metrics::render(char* buffer, size_t size, size_t len) {
+    std::lock_guard<std::mutex> guard(lock);
+
+    const char* last_name = nullptr;
+    for (size_t index = 0; index < (size_t)MetricHistogram::COUNT; index++) {
+        const HistogramInfo& info = histogram_info[index];
+        const Histogram& h = histograms[index];
+        const char* sep = info.label ? "," : "";
+        const char* label = info.label ? info.label : "";
+
+        // Series of one metric share the header
+        if (last_name == nullptr || strcmp(last_name, info.name) != 0) {
+            len = metrics_printf(buffer, size, len, "# HELP %s %s\n# TYPE %s histogram\n", info.name, info.help, info.name);
+            last_name = info.name;
+        }
+
+        uint32_t cumulative = 0;
+        for (size_t i = 0; i < MAX_BUCKETS && info.bounds[i] != 0; i++) {
+            cumulative += h.buckets[i];
+            len = metrics_printf(buffer, size, len, "%s_bucket{%s%sle=\"%u\"} %u\n",
+                                 info.name, label, sep, (unsigned)info.bounds[i], (unsigned)cumulative);
+        }
+        len = metrics_printf(buffer, size, len, "%s_bucket{%s%sle=\"+Inf\"} %u\n", info.name, label, sep, (unsigned)h.count);
+        if (info.label) {
+            len = metrics_printf(buffer, size, len, "%s_sum{%s} %llu\n%s_count{%s} %u\n",
+                                 info.name, label, (unsigned long long)h.sum, info.name, label, (unsigned)h.count);
+        } else {
+            len = metrics_printf(buffer, size, len, "%s_sum %llu\n%s_count %u\n",
+                                 info.name, (unsigned long long)h.sum, info.name, (unsigned)h.count);
+        }
+    }
+
+    len = metrics_printf(buffer, size, len, "# HELP volumio_request_errors_total Failed Volumio HTTP requests\n"
+                                            "# TYPE volumio_request_errors_total counter\n");
+    len = metrics_printf(buffer, size, len, "volumio_request_errors_total{request=\"state\"} %u\n",
+                         (unsigned)histograms[(size_t)MetricHistogram::VOLUMIO_STATE].errors);
+    len = metrics_printf(buffer, size, len, "volumio_request_errors_total{request=\"command\"} %u\n",
+                         (unsigned)histograms[(size_t)MetricHistogram::VOLUMIO_COMMAND].errors);
+
+    len = metrics_printf(buffer, size, len, "# HELP queue_dropped_total Items dropped because a queue was full\n"
+                                            "# TYPE queue_dropped_total counter\n");
+    for (size_t i = 0; i < (size_t)MetricQueue::COUNT; i++) {
+        len = metrics_printf(buffer, size, len, "queue_dropped_total{queue=\"%s\"} %u\n", queue_names[i], (unsigned)drops[i]);
+    }
+    return len;
+}
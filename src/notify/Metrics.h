@@ -0,0 +1,103 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+
+#define METRICS_BUFFER      8192    // Rendered /metrics page [B]
+#define METRICS_MAX_TASKS   6       // Tasks reported with their stack high-water mark
+
+/**
+ * @brief Latency histograms exported on /metrics
+ */
+enum class MetricHistogram : uint8_t {
+    VOLUMIO_STATE,      // getState request [ms]
+    VOLUMIO_COMMAND,    // Command request [ms]
+    FRAME_TIME,         // LVGL refresh [us]
+    COUNT
+};
+
+/**
+ * @brief Queues whose dropped items are counted
+ */
+enum class MetricQueue : uint8_t {
+    COMMAND,
+    TRACK_DATA,
+    NOTIFICATION,
+    WIFI_EVENT,
+    BUTTON,
+    EVENT_STREAM,
+    COUNT
+};
+
+/**
+ * @brief Process-wide counters rendered in the Prometheus text format
+ *
+ * Histograms use fixed buckets, so recording never allocates. render()
+ * writes into a caller supplied buffer - the web server reuses one static
+ * buffer for every scrape.
+ */
+class Metrics {
+public:
+    static constexpr size_t MAX_BUCKETS = 10;
+
+private:
+    struct Histogram {
+        uint32_t buckets[MAX_BUCKETS];  // Non-cumulative, cumulated when rendered
+        uint32_t count;
+        uint64_t sum;
+        uint32_t errors;
+    };
+
+    std::mutex lock;
+    Histogram histograms[(size_t)MetricHistogram::COUNT] = {};
+    uint32_t drops[(size_t)MetricQueue::COUNT] = {};
+    TaskHandle_t tasks[METRICS_MAX_TASKS] = {};
+    size_t task_count = 0;
+
+    static Metrics* instance;
+    Metrics();
+
+public:
+    ~Metrics();
+
+    Metrics(const Metrics&) = delete;
+    void operator=(const Metrics&) = delete;
+
+    static Metrics& getInstance();
+
+    void observe(MetricHistogram histogram, uint32_t value);
+    void error(MetricHistogram histogram);
+    void drop(MetricQueue queue);
+
+    /**
+     * @brief Report the task's stack high-water mark - call from the task itself
+     */
+    void registerTask(TaskHandle_t task);
+    size_t getTasks(TaskHandle_t* out, size_t max);
+
+    /**
+     * @brief Append histograms and drop counters to the buffer
+     * @return new length, size if the page did not fit (see metrics_printf)
+     */
+    size_t render(char* buffer, size_t size, size_t len);
+};
+
+/**
+ * @brief snprintf at the end of the buffer
+ *
+ * Output that does not fit is cut back to the last complete line and the
+ * call returns size. Further calls with that length append nothing, so a
+ * truncated page is never mistaken for a complete one.
+ *
+ * @return new length, size once the buffer overflowed - it then holds the
+ *         complete lines before the overflow, NUL terminated
+ */
+size_t metrics_printf(char* buffer, size_t size, size_t len, const char* format, ...);
+
+#endif // METRICS_H
@@ -1,4 +1,5 @@
 #include "NotificationManager.h"
+#include "Metrics.h"
 
 NotificationManager* NotificationManager::instance = nullptr;
 
@@ -37,6 +38,7 @@ bool NotificationManager::postNotification(const std::string& title, const std::
     BaseType_t result = xQueueSend(eventQueue, &eventPtr, 0);
 
     if (result != pdTRUE) {
+        Metrics::getInstance().drop(MetricQueue::NOTIFICATION);
         delete eventPtr;
         return false;
     }
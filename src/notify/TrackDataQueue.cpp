@@ -1,5 +1,6 @@
 #include "TrackDataQueue.h"
 #include "dev_tools.h"
+#include "Metrics.h"
 #include <stdlib.h>
 #include <cstring>
 
@@ -40,6 +41,7 @@ bool TrackDataQueue::postTrackData(const Info& info) {
     BaseType_t result = xQueueSend(trackDataQueue, &infoPtr, 0);
 
     if (result != pdTRUE) {
+        Metrics::getInstance().drop(MetricQueue::TRACK_DATA);
         delete infoPtr;
         return false;
     }
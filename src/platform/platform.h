@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#define PLATFORM_HTTP_OK        200
+
+class ResolverBackend;
+
+/**
+ * @brief Hardware abstraction used by the logic layers
+ *
+ * The device implementation (platform_esp32.cpp) maps these calls to the
+ * Arduino / ESP-IDF APIs, the host build (src/host/platform) to a virtual
+ * clock, a pluggable HTTP stand-in and simulated pins. Queues keep using the
+ * FreeRTOS API directly - the host build provides it in src/host/include.
+ *
+ * Only code that has to run on both targets goes through here. Drivers, ISRs
+ * and the WiFi / web server glue stay on the native APIs.
+ */
+
+// Clock
+uint32_t platform_millis(void);
+int64_t platform_micros(void);
+void platform_delay(uint32_t ms);
+
+// Tasks
+typedef void (*platform_task_fn)(void* param);
+
+/**
+ * @brief Start a task
+ * @param core CPU the task is pinned to
+ * @return false if the task could not be created
+ */
+bool platform_task_create(platform_task_fn entry, const char* name, uint32_t stack,
+                          void* param, uint32_t priority, int core);
+
+// Network
+bool platform_net_connected(void);
+
+/**
+ * @brief Blocking HTTP GET
+ * @param body response body, filled on any HTTP status (may be nullptr)
+ * @return HTTP status code, negative on transport errors (no connection, timeout)
+ */
+int platform_http_get(const std::string& url, std::string* body);
+
+/**
+ * @brief Name lookups (mDNS, DNS-SD, unicast DNS) for the VolumioResolver
+ */
+ResolverBackend& platform_resolver_backend(void);
+
+// GPIO
+int platform_gpio_read(int pin);
+void platform_gpio_write(int pin, int level);
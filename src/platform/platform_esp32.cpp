@@ -0,0 +1,54 @@
+#include "platform.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "../volumio/MdnsBackend.h"
+
+uint32_t platform_millis(void) {
+    return millis();
+}
+
+int64_t platform_micros(void) {
+    return esp_timer_get_time();
+}
+
+void platform_delay(uint32_t ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+bool platform_task_create(platform_task_fn entry, const char* name, uint32_t stack,
+                          void* param, uint32_t priority, int core) {
+    return xTaskCreatePinnedToCore(entry, name, stack, param, priority, NULL, core) == pdPASS;
+}
+
+bool platform_net_connected(void) {
+    return WiFi.status() == WL_CONNECTED;
+}
+
+int platform_http_get(const std::string& url, std::string* body) {
+    HTTPClient http;
+    http.begin(url.c_str());
+    int httpCode = http.GET();
+    if (httpCode > 0 && body != nullptr) {
+        *body = http.getString().c_str();
+    }
+    http.end();
+    return httpCode;
+}
+
+ResolverBackend& platform_resolver_backend(void) {
+    static MdnsBackend backend;
+    return backend;
+}
+
+int platform_gpio_read(int pin) {
+    return gpio_get_level(static_cast<gpio_num_t>(pin));
+}
+
+void platform_gpio_write(int pin, int level) {
+    gpio_set_level(static_cast<gpio_num_t>(pin), level);
+}
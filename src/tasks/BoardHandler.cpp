@@ -2,14 +2,17 @@
 #include "dev_tools.h"
 #include "../lvgl/styles/styles.h"
 #include "../notify/NotificationManager.h"
+#include "../platform/platform.h"
 #include "esp_sleep.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
 #include "driver/gpio.h"
 
 BoardHandler::BoardHandler(){
     // Power hold after boot
     gpio_reset_pin(HOLD_PIN);
     gpio_set_direction(HOLD_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level(HOLD_PIN, 1);
+    platform_gpio_write(HOLD_PIN, 1);
 
     // Encoder
     gpio_reset_pin(BUTTON_PIN);
@@ -20,15 +23,13 @@ BoardHandler::BoardHandler(){
     esp_sleep_enable_gpio_wakeup();
     gpio_wakeup_enable(BUTTON_PIN, GPIO_INTR_NEGEDGE);
 
+    // Button events - edge interrupt + timer, no polling
+    button.begin();
+
     // Battery
     Wire1.begin(SDA, SCL);
     vTaskDelay(pdMS_TO_TICKS(10));
-    lipo = new Adafruit_MAX17048();
-    if(!lipo->begin(&Wire1)) {
-        delete lipo;
-        lipo = nullptr;
-        DEBUG_PRINTLN("[Battery] Failed to initialize MAX17048");
-    }
+    battery.begin(&Wire1);
 
     // Display
     lcd.init();
@@ -36,10 +37,22 @@ BoardHandler::BoardHandler(){
     touch.init();
     vTaskDelay(pdMS_TO_TICKS(10));
 
+    // Touch interrupt - the controller is only read after it signals a touch
+    touch_signal = xSemaphoreCreateBinary();
+    gpio_set_intr_type(static_cast<gpio_num_t>(TOUCH_IRQ), GPIO_INTR_NEGEDGE);
+    esp_err_t isr_ret = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if (isr_ret != ESP_OK && isr_ret != ESP_ERR_INVALID_STATE) {
+        DEBUG_PRINTLN("[Touch] Failed to install GPIO ISR service: " << esp_err_to_name(isr_ret));
+    }
+    gpio_isr_handler_add(static_cast<gpio_num_t>(TOUCH_IRQ), BoardHandler::TouchIsr, this);
+
     // LVGL setup
-    draw_buf = (lv_color_t*)malloc(DRAW_BUF_SIZE/BUF_DIVIDER);
-    if(draw_buf == nullptr) {
-        return;
+    for (int i = 0; i < DISPLAY_BUF_COUNT; i++) {
+        draw_buf[i] = (uint8_t*)heap_caps_malloc(DRAW_BUF_SIZE, DISPLAY_BUF_CAPS);
+        if(draw_buf[i] == nullptr) {
+            DEBUG_PRINTLN("[Display] Failed to allocate draw buffer " << i << " (" << DRAW_BUF_SIZE << " B)");
+            return;
+        }
     }
     lv_init();
     lv_tick_set_cb(BoardHandler::my_tick);
@@ -50,13 +63,22 @@ BoardHandler::BoardHandler(){
     lv_display_set_flush_cb(lvDisplay, BoardHandler::DisplayFlush);
     lv_display_set_user_data(lvDisplay, this);
     lv_display_set_rotation(lvDisplay, TFT_ROTATION);
-    lv_display_set_buffers(lvDisplay, draw_buf, NULL, DRAW_BUF_SIZE/BUF_DIVIDER, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    #if DISPLAY_RENDER_MODE == RENDER_MODE_DIRECT
+        lv_display_render_mode_t render_mode = LV_DISPLAY_RENDER_MODE_DIRECT;
+    #else
+        lv_display_render_mode_t render_mode = LV_DISPLAY_RENDER_MODE_PARTIAL;
+    #endif
+    lv_display_set_buffers(lvDisplay, draw_buf[0], DISPLAY_BUF_COUNT > 1 ? draw_buf[1] : NULL,
+                           DRAW_BUF_SIZE, render_mode);
+    lv_display_add_event_cb(lvDisplay, DisplayRefreshEvent, LV_EVENT_REFR_START, this);
+    lv_display_add_event_cb(lvDisplay, DisplayRefreshEvent, LV_EVENT_REFR_READY, this);
 
-    // Setup LVGL touch
-    lv_indev_t* touch_indev = lv_indev_create();
+    // Setup LVGL touch - read on demand from PollTouch() instead of every indev timer cycle
+    touch_indev = lv_indev_create();
     lv_indev_set_type(touch_indev, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(touch_indev, TouchEvent);
     lv_indev_set_user_data(touch_indev, this);
+    lv_indev_set_mode(touch_indev, LV_INDEV_MODE_EVENT);
 
     // Setup LVGL encoder
     lv_indev_t* encoder_indev = lv_indev_create();
@@ -64,13 +86,6 @@ BoardHandler::BoardHandler(){
     lv_indev_set_read_cb(encoder_indev, EncoderEvent);
     lv_indev_set_user_data(encoder_indev, this);
 
-    // Setup LVGL battery
-    lv_indev_t* battery_indev = lv_indev_create();
-    lv_indev_set_type(battery_indev, LV_INDEV_TYPE_NONE);
-    lv_indev_set_read_cb(battery_indev, BatteryEvent);
-    lv_indev_set_user_data(battery_indev, this);
-
-    semaphore = xSemaphoreCreateMutex();
 
     // Subscribe to notifications
     NotificationManager::getInstance().subscribe(
@@ -80,6 +95,46 @@ BoardHandler::BoardHandler(){
     );
 }
 
+void IRAM_ATTR BoardHandler::TouchIsr(void* arg) {
+    BoardHandler* instance = static_cast<BoardHandler*>(arg);
+    instance->touch_irq_us = (uint32_t)esp_timer_get_time();
+    instance->touch_irq_pending = true;
+
+    BaseType_t woken = pdFALSE;
+    if (instance->touch_signal != nullptr) {
+        xSemaphoreGiveFromISR(instance->touch_signal, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+void BoardHandler::PollTouch(void) {
+    #if TOUCH_VERBOSE == true
+    TickType_t now = xTaskGetTickCount();
+    if (now - touch_stats_start >= pdMS_TO_TICKS(TOUCH_STATS_PERIOD)) {
+        uint32_t period_ms = pdTICKS_TO_MS(now - touch_stats_start);
+        DEBUG_PRINTLN("[Touch] I2C reads/s: " << (touch.takeReadCount() * 1000 / (period_ms ? period_ms : 1))
+                      << ", latency avg: " << (touch_latency_count ? (uint32_t)(touch_latency_sum / touch_latency_count) : 0) << " us"
+                      << ", max: " << touch_latency_max << " us"
+                      << ", touches: " << touch_latency_count);
+        touch_latency_count = 0;
+        touch_latency_sum = 0;
+        touch_latency_max = 0;
+        touch_stats_start = now;
+    }
+    #endif
+
+    if (touch_indev == nullptr) {
+        return;
+    }
+
+    // Nothing pending and not touched - no bus access at all
+    if (!touch_irq_pending && !touch_filter.isPressed() && !touch.isIrqActive()) {
+        return;
+    }
+
+    lv_indev_read(touch_indev);
+}
+
 void BoardHandler::TouchEvent(lv_indev_t *indev, lv_indev_data_t *data) {
     BoardHandler* instance = static_cast<BoardHandler*>(lv_indev_get_user_data(indev));
     if (instance == nullptr) {
@@ -87,20 +142,71 @@ void BoardHandler::TouchEvent(lv_indev_t *indev, lv_indev_data_t *data) {
         return;
     }
 
+    bool irq_pending = instance->touch_irq_pending;
+    instance->touch_irq_pending = false;
+
+    // INT released - the finger is up, no need to ask the controller
+    if (!instance->touch.isIrqActive()) {
+        instance->touch_filter.release();
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+
+    // The touch that woke the screen up, or the rest of a gesture - not passed to the UI
+    if (instance->touch_filter.isSuppressed()) {
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+
+    // One burst - gesture id, point count and first point
     instance->touch.readPos();
-    FT3267::TouchPoint_t point = instance->touch.getTouchPointBuffer();
+    bool was_pressed = instance->touch_filter.isPressed();
+    TouchFilter::Report report = instance->touch_filter.feed(instance->touch.getRegisterDump());
 
     #if TOUCH_VERBOSE == true
-    DEBUG_PRINTLN("[Touch] Touch num: " << point.touch_num << ", X: " << point.x << ", Y: " << point.y);
+    DEBUG_PRINTLN("[Touch] Pressed: " << report.pressed << ", X: " << report.x << ", Y: " << report.y
+                  << ", gesture: " << (int)instance->touch.getGesture());
     #endif
 
-    if (point.touch_num > 0 && point.x >= 0 && point.y >= 0) {
-        data->state = LV_INDEV_STATE_PRESSED;
-        data->point.x = point.x;
-        data->point.y = point.y;
-    } else {
-        data->state = LV_INDEV_STATE_RELEASED;
+    // Gesture from the same burst - cancel the press LVGL has seen instead of releasing it,
+    // a release would click the widget under the start point
+    if (report.gesture) {
+        instance->HandleGesture(report.cmd);
+        instance->touch_latency_pending = false;
+        lv_indev_reset(indev, NULL);
+        lv_indev_wait_release(indev);
     }
+    // New touch - measure until the next frame is on the panel
+    else if (report.pressed && !was_pressed && irq_pending) {
+        instance->touch_latency_start = instance->touch_irq_us;
+        instance->touch_latency_pending = true;
+    }
+
+    data->state = report.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->point.x = report.x;
+    data->point.y = report.y;
+}
+
+void BoardHandler::HandleGesture(const VolumioCommand& cmd) {
+    CommandQueue::getInstance().postCommand(cmd);
+
+    switch (cmd.type) {
+        case VolumioCommandType::NEXT:
+            NotificationManager::getInstance().postNotification("Next", LV_SYMBOL_NEXT, 1000);
+            break;
+        case VolumioCommandType::PREV:
+            NotificationManager::getInstance().postNotification("Previous", LV_SYMBOL_PREV, 1000);
+            break;
+        case VolumioCommandType::VOLUME:
+            NotificationManager::getInstance().postNotification("Volume", cmd.value > 0 ? LV_SYMBOL_VOLUME_MAX : LV_SYMBOL_VOLUME_MID, 1000);
+            break;
+        default:
+            break;
+    }
+
+    #if TOUCH_VERBOSE == true
+    DEBUG_PRINTLN("[Touch] Gesture command: " << (int)cmd.type << ", value: " << cmd.value);
+    #endif
 }
 
 void BoardHandler::EncoderEvent(lv_indev_t *indev, lv_indev_data_t *data) {
@@ -111,7 +217,9 @@ void BoardHandler::EncoderEvent(lv_indev_t *indev, lv_indev_data_t *data) {
         return;
     }
 
-    int32_t diff = instance->encoder.getDiff();
+    // All detents since the last read in one batch - accelerated for fast spins
+    EncoderBatch batch = instance->encoder.poll();
+    int32_t diff = batch.accelerated;
     data->enc_diff = diff;
 
     if (diff != 0 && instance->dashboard != nullptr) {
@@ -126,67 +234,122 @@ void BoardHandler::EncoderEvent(lv_indev_t *indev, lv_indev_data_t *data) {
     }
 
     #if ENCODER_VERBOSE == true
-    static int32_t last_logged_diff = 0;
-    if (diff != 0 && diff != last_logged_diff) {
-        DEBUG_PRINTLN("[Encoder] Diff: " << diff << ", Position: " << instance->encoder.getPosition());
-        last_logged_diff = diff;
+    if (batch.count != 0 || batch.glitches != 0) {
+        DEBUG_PRINTLN("[Encoder] Detents: " << batch.steps << ", accelerated: " << diff
+                      << ", velocity: " << batch.velocity << "/s"
+                      << ", span: " << (batch.last_us - batch.first_us) << " us"
+                      << ", glitches: " << batch.glitches
+                      << ", Position: " << instance->encoder.getPosition());
     }
     #endif
 
-    // TODO handle press to toggle play / pause
-    // TODO handle 5x press to toggle STA / APmode
-    static TickType_t button_press_start = 0;
-    if (gpio_get_level(BUTTON_PIN) == 0) {
-        if (button_press_start == 0) {
-            button_press_start = xTaskGetTickCount();
-        }
-        else {
-            TickType_t hold_time = xTaskGetTickCount() - button_press_start;
-            if (hold_time >= DEEP_SLEEP_HOLD_TIME) {
-                gpio_set_level(HOLD_PIN, 0);
-                esp_deep_sleep_start();
+    data->state = instance->button_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+void BoardHandler::ProcessButton(void) {
+    ButtonEvent event;
+    while (button.getEvent(event)) {
+        HandleButton(event);
+    }
+}
+
+void BoardHandler::HandleButton(const ButtonEvent& event) {
+    // The press that wakes the screen only wakes it
+    if (!idle.isRendering() && event.type == ButtonEvent::Type::PRESS) {
+        suppress_button = true;
+    }
+    lv_display_trigger_activity(NULL);
+
+    #if ENCODER_VERBOSE == true
+    DEBUG_PRINTLN("[Button] Event: " << (int)event.type << ", clicks: " << (int)event.clicks << ", held: " << event.held_ms << " ms");
+    #endif
+
+    switch (event.type) {
+        case ButtonEvent::Type::PRESS:
+            button_pressed = true;
+            break;
+
+        case ButtonEvent::Type::RELEASE:
+            button_pressed = false;
+            break;
+
+        case ButtonEvent::Type::CLICK:
+            if (suppress_button) {
+                suppress_button = false;
             }
-            else if(hold_time >= DEEP_SLEEP_HOLD_TIME - 1000){
-                NotificationManager::getInstance().postNotification("Sleep", "Turn off in\n1 second", 3000);
+            else if (event.clicks == 1) {
+                VolumioCommand cmd = {VolumioCommandType::TOGGLE, 0};
+                CommandQueue::getInstance().postCommand(cmd);
             }
-            else if(hold_time >= DEEP_SLEEP_HOLD_TIME - 2000){
-                NotificationManager::getInstance().postNotification("Sleep", "Turn off in\n2 seconds", 3000);
+            else if (event.clicks == PLAYER_SELECT_CLICKS) {
+                VolumioCommand cmd = {VolumioCommandType::SELECT_PLAYER, -1};
+                CommandQueue::getInstance().postCommand(cmd);
             }
-            else if(hold_time >= DEEP_SLEEP_HOLD_TIME - 3000){
-                NotificationManager::getInstance().postNotification("Sleep", "Turn off in\n3 seconds", 3000);
+            else if (event.clicks == WIFI_MODE_CLICKS) {
+                VolumioCommand cmd = {VolumioCommandType::TOGGLE_WIFI_MODE, 0};
+                CommandQueue::getInstance().postCommand(cmd);
+                NotificationManager::getInstance().postNotification("WiFi", "Switching mode", 2000);
             }
+            break;
+
+        case ButtonEvent::Type::LONG_PRESS:
+        case ButtonEvent::Type::HOLD: {
+            if (suppress_button) {
+                break;
+            }
+
+            // Sleep countdown for the last seconds of the hold
+            uint32_t hold_time = pdTICKS_TO_MS(DEEP_SLEEP_HOLD_TIME);
+            if (event.held_ms >= hold_time) {
+                ConfigStore::getInstance().flush();
+                platform_gpio_write(HOLD_PIN, 0);
+                esp_deep_sleep_start();
+            }
+
+            uint32_t remaining = (hold_time - event.held_ms + 999) / 1000;
+            if (remaining <= 3) {
+                std::string content = "Turn off in\n" + std::to_string(remaining) + (remaining == 1 ? " second" : " seconds");
+                NotificationManager::getInstance().postNotification("Sleep", content, 3000);
+            }
+            break;
         }
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else {
-        if(button_press_start != 0){
-            instance->HidePopup();
-        }
-        // Button released, reset timer
-        button_press_start = 0;
-        data->state = LV_INDEV_STATE_RELEASED;
+
+        case ButtonEvent::Type::LONG_RELEASE:
+            // Released before the countdown ended
+            if (suppress_button) {
+                suppress_button = false;
+            }
+            else {
+                HidePopup();
+            }
+            break;
     }
 }
 
-void BoardHandler::BatteryEvent(lv_indev_t *indev, lv_indev_data_t *data) {
-    BoardHandler* instance = static_cast<BoardHandler*>(lv_indev_get_user_data(indev));
-    if(instance == nullptr) {
+void BoardHandler::BatteryTimer(lv_timer_t *timer) {
+    BoardHandler* instance = static_cast<BoardHandler*>(lv_timer_get_user_data(timer));
+    if (instance == nullptr || instance->dashboard == nullptr) {
         return;
     }
 
-    if(instance->lipo == nullptr) {
-        instance->dashboard->HideBatteryIcon();
-        return;
+    if (instance->battery.update(xTaskGetTickCount())) {
+        instance->dashboard->SetBatteryValue(instance->battery.getDisplayValue());
+        EventStream::getInstance().publishBattery(instance->battery.getDisplayValue());
     }
-
-    instance->dashboard->SetBatteryValue((int)instance->lipo->cellPercent());
 }
 
 BoardHandler::~BoardHandler(){
-    if (draw_buf != nullptr) {
-        free(draw_buf);
-        draw_buf = nullptr;
+    gpio_isr_handler_remove(static_cast<gpio_num_t>(TOUCH_IRQ));
+    if (touch_signal != nullptr) {
+        vSemaphoreDelete(touch_signal);
+        touch_signal = nullptr;
+    }
+    for (int i = 0; i < DISPLAY_BUF_COUNT; i++) {
+        if (draw_buf[i] != nullptr) {
+            heap_caps_free(draw_buf[i]);
+            draw_buf[i] = nullptr;
+        }
     }
-    vSemaphoreDelete(semaphore);
     vTaskDelete(NULL);
 }
 
@@ -201,44 +364,201 @@ void BoardHandler::DisplayFlush(lv_display_t *display, const lv_area_t *area, un
     uint32_t w = lv_area_get_width(area);
     uint32_t h = lv_area_get_height(area);
 
-    lv_draw_sw_rgb565_swap(data, w * h);
-
-    instance->lcd.pushImageDMA(area->x1, area->y1, w, h, (uint16_t *)data);
+    #if DISPLAY_RENDER_MODE == RENDER_MODE_DIRECT
+        // Full frame buffer - push the dirty rows, swapping bytes on the fly to keep the buffer intact
+        const lgfx::swap565_t* frame = (const lgfx::swap565_t*)data;
+        instance->lcd.startWrite();
+        for (int32_t y = area->y1; y <= area->y2; y++) {
+            instance->lcd.pushImage(area->x1, y, w, 1, frame + y * LCD_WIDTH + area->x1);
+        }
+        instance->lcd.endWrite();
+    #else
+        lv_draw_sw_rgb565_swap(data, w * h);
+        instance->lcd.pushImageDMA(area->x1, area->y1, w, h, (uint16_t *)data);
+
+        // With a single buffer LVGL renders the next stripe into the same memory
+        if (DISPLAY_BUF_COUNT == 1) {
+            instance->lcd.waitDMA();
+        }
+    #endif
 
     lv_display_flush_ready(display); /* tell lvgl that flushing is done */
 }
 
+void BoardHandler::ResetFrameStats(void) {
+    frame_count = 0;
+    frame_time_sum = 0;
+    frame_time_max = 0;
+    frame_stats_start = xTaskGetTickCount();
+}
+
+void BoardHandler::DisplayRefreshEvent(lv_event_t *e) {
+    BoardHandler* instance = static_cast<BoardHandler*>(lv_event_get_user_data(e));
+    if (instance == nullptr) return;
+
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        instance->frame_start = esp_timer_get_time();
+        return;
+    }
+
+    int64_t frame_end = esp_timer_get_time();
+    uint32_t frame_time = (uint32_t)(frame_end - instance->frame_start);
+    instance->frame_count++;
+    instance->frame_time_sum += frame_time;
+    if (frame_time > instance->frame_time_max) {
+        instance->frame_time_max = frame_time;
+    }
+    Metrics::getInstance().observe(MetricHistogram::FRAME_TIME, frame_time);
+
+    // First frame after a touch - touch-to-pixel latency
+    if (instance->touch_latency_pending) {
+        uint32_t latency = (uint32_t)frame_end - instance->touch_latency_start;
+        instance->touch_latency_pending = false;
+        instance->touch_latency_count++;
+        instance->touch_latency_sum += latency;
+        if (latency > instance->touch_latency_max) {
+            instance->touch_latency_max = latency;
+        }
+    }
+
+    #if DISPLAY_VERBOSE == true
+    TickType_t now = xTaskGetTickCount();
+    if (now - instance->frame_stats_start >= pdMS_TO_TICKS(DISPLAY_STATS_PERIOD)) {
+        DEBUG_PRINTLN("[Display] Frames: " << instance->frame_count
+                      << ", avg: " << (uint32_t)(instance->frame_time_sum / instance->frame_count) << " us"
+                      << ", max: " << instance->frame_time_max << " us"
+                      << ", draw units: " << LV_DRAW_SW_DRAW_UNIT_CNT
+                  #ifdef POPUP_ANIMATION_ENABLE
+                  << ", popup: layer animation"
+                  #else
+                  << ", popup: no animation"
+                  #endif
+                  );
+        instance->ResetFrameStats();
+    }
+    #endif
+}
+
 void BoardHandler::RunTask(void){
-    xTaskCreatePinnedToCore(TaskEntry,      // Task entry point
-                            "DisplayTask",  // Task name
-                            8192,           // Stack depth
-                            this,           // Task parameters - pointer to this instance
-                            3,              // Task priority
-                            NULL,           // Task handle
-                            0);             // Core ID (Core 0 - Fast Core)
+    platform_task_create(TaskEntry,         // Task entry point
+                         "DisplayTask",     // Task name
+                         8192,              // Stack depth
+                         this,              // Task parameters - pointer to this instance
+                         3,                 // Task priority
+                         0);                // Core ID (Core 0 - Fast Core)
 }
 
 void BoardHandler::TaskEntry(void* param) {
     BoardHandler* instance = static_cast<BoardHandler*>(param);
+    Metrics::getInstance().registerTask(xTaskGetCurrentTaskHandle());
 
+    lv_lock();
     instance->dashboard = new Dashboard();
     lv_scr_load(instance->dashboard->GetScreen());
 
+    // Battery - the timer only checks the alert flag, the fuel gauge is read at BATTERY_SAMPLE_PERIOD
+    if (instance->battery.isAvailable()) {
+        lv_timer_t* battery_timer = lv_timer_create(BatteryTimer, 1000, instance);
+        lv_timer_ready(battery_timer);
+    } else {
+        instance->dashboard->HideBatteryIcon();
+    }
+    lv_unlock();
+
+    #if DISPLAY_BENCHMARK == true
+    instance->RunBenchmark();
+    #endif
+
+    instance->lcd.setBrightness(instance->idle.getBrightness());
+
     while (true) {
-        if(xSemaphoreTake(instance->semaphore, 10) == pdTRUE){
+        lv_lock();
+        NotificationManager::getInstance().processNotifications();
+        instance->processTrackData();
+        instance->ProcessButton();
+        if (instance->idle.isRendering()) {
+            instance->PollTouch();
+        }
+        instance->UpdateIdle();
+        lv_unlock();
+
+        // Wait for the next frame - a touch interrupt ends the wait early
+        if (instance->touch_signal != nullptr) {
+            xSemaphoreTake(instance->touch_signal, pdMS_TO_TICKS(instance->idle.getFramePeriod()));
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(instance->idle.getFramePeriod()));
+        }
+    }
+}
+
+bool BoardHandler::CheckWakeup(void) {
+    // Encoder turned - drop the steps, they only wake the screen
+    if (encoder.getPosition() != wake_encoder_position) {
+        encoder.getDiff();
+        return true;
+    }
+
+    // Touch controller pulls the IRQ line low while touched
+    if (touch_irq_pending || touch.isIrqActive()) {
+        touch_irq_pending = false;
+        touch_filter.suppress();
+        return true;
+    }
+
+    return false;
+}
+
+void BoardHandler::UpdateIdle(void) {
+    #if DISPLAY_VERBOSE == true
+    IdleManager::State previous = idle.getState();
+    #endif
+
+    if (!idle.isRendering() && CheckWakeup()) {
+        lv_display_trigger_activity(NULL);
+    }
+
+    if (!idle.update(lv_display_get_inactive_time(NULL))) {
+        if (idle.isRendering()) {
             lv_timer_handler();
-            NotificationManager::getInstance().processNotifications();
-            instance->processTrackData();
-            xSemaphoreGive(instance->semaphore);
         }
-        vTaskDelay(1000 / DISPLAY_FPS);
+        return;
     }
+
+    IdleManager::State state = idle.getState();
+
+    // Nobody is looking - poll the selected player less often
+    VolumioCommand poll = {VolumioCommandType::POLL_PERIOD, (int)idle.getPollPeriod()};
+    CommandQueue::getInstance().postCommand(poll);
+
+    if (state == IdleManager::State::OFF) {
+        // Rendering paused - remember the encoder to detect a wake-up turn
+        wake_encoder_position = encoder.getPosition();
+        lcd.setBrightness(idle.getBrightness());
+        DEBUG_PRINTLN("[Display] Idle: screen off");
+        return;
+    }
+
+    // Render pending changes before the backlight comes back on
+    #if DISPLAY_VERBOSE == true
+    int64_t wake_start = esp_timer_get_time();
+    #endif
+    lv_timer_handler();
+    lcd.setBrightness(idle.getBrightness());
+
+    #if DISPLAY_VERBOSE == true
+    if (previous == IdleManager::State::OFF) {
+        DEBUG_PRINTLN("[Display] Wake latency: " << (uint32_t)(esp_timer_get_time() - wake_start) << " us"
+                      << " (+ up to " << IDLE_WAKE_POLL_PERIOD << " ms polling)");
+    }
+    #endif
+    DEBUG_PRINTLN("[Display] Idle: " << (state == IdleManager::State::DIMMED ? "dimmed" : "active"));
 }
 
 void BoardHandler::ShowPopup(const char *title, const char *content, TickType_t duration) {
     if (dashboard != nullptr) {
         dashboard->ShowPopup(title, content, duration);
     }
+    EventStream::getInstance().publishPopup(title, content);
 }
 
 void BoardHandler::HidePopup(void) {
@@ -267,6 +587,13 @@ void BoardHandler::processTrackData(void) {
     Info trackData;
     std::string tempString;
     while (TrackDataQueue::getInstance().getTrackData(trackData)) {
+        // Track or playback state change wakes the screen
+        if (trackData.title != last_title || trackData.status != last_status) {
+            last_title = trackData.title;
+            last_status = trackData.status;
+            lv_display_trigger_activity(NULL);
+        }
+
         tempString = (trackData.title == "null" ? "-" : trackData.title);
         dashboard->SetTrackTitle(tempString.c_str());
 
@@ -305,5 +632,107 @@ void BoardHandler::processTrackData(void) {
 
         dashboard->SetPlayerIcon(theme->icon);
         dashboard->SetAccentColor(theme->color);
+
+        LatencyTracer::getInstance().mark(trackData.trace_id, TraceStage::DISPLAYED);
+    }
+}
+
+void BoardHandler::BenchmarkPhase(const char* name, void (*step)(BoardHandler*, uint32_t)) {
+    lv_lock();
+    ResetFrameStats();
+    lv_unlock();
+
+    TickType_t start = xTaskGetTickCount();
+    uint32_t elapsed = 0;
+    while (elapsed < BENCHMARK_PHASE_TIME) {
+        lv_lock();
+        step(this, elapsed);
+        lv_timer_handler();
+        lv_unlock();
+        vTaskDelay(1000 / DISPLAY_FPS);
+        elapsed = pdTICKS_TO_MS(xTaskGetTickCount() - start);
+    }
+
+    lv_lock();
+    DEBUG_PRINTLN("[Benchmark] " << name
+                  << ": frames " << frame_count
+                  << ", avg " << (frame_count ? (uint32_t)(frame_time_sum / frame_count) : 0) << " us"
+                  << ", max " << frame_time_max << " us"
+                  << ", free heap " << heap_caps_get_free_size(MALLOC_CAP_INTERNAL) << " B"
+                  << ", min free heap " << heap_caps_get_minimum_free_size(MALLOC_CAP_INTERNAL) << " B");
+    lv_unlock();
+}
+
+void BoardHandler::RunBenchmark(void) {
+    if (dashboard == nullptr) {
+        return;
     }
-}
\ No newline at end of file
+
+    // Widget options the phases depend on, to tell runs apart
+    #ifdef POPUP_ANIMATION_ENABLE
+    const char* popup_mode = "layer animation";
+    #else
+    const char* popup_mode = "no animation";
+    #endif
+
+    DEBUG_PRINTLN("[Benchmark] Mode: " << (DISPLAY_RENDER_MODE == RENDER_MODE_DIRECT ? "direct" : "partial")
+                  << ", buffers: " << DISPLAY_BUF_COUNT
+                  << ", lines: " << (DISPLAY_RENDER_MODE == RENDER_MODE_DIRECT ? LCD_HEIGHT : DISPLAY_BUF_LINES)
+                  << ", buffer RAM: " << DRAW_BUF_SIZE * DISPLAY_BUF_COUNT << " B"
+                  << ", draw units: " << LV_DRAW_SW_DRAW_UNIT_CNT
+                  << " (core " << DRAW_THREAD_CORE << ", priority " << DRAW_THREAD_PRIORITY << ")");
+    DEBUG_PRINTLN("[Benchmark] Popup: " << popup_mode
+                  << ", arc track cache: " << (ARC_TRACK_CACHE_ENABLE ? "on" : "off"));
+
+    // Same track for every run - long title to keep the labels scrolling
+    lv_lock();
+    dashboard->SetTrackTitle("Benchmark - A Very Long Track Title That Keeps Scrolling");
+    dashboard->SetTrackArtist("Benchmark Artist - Benchmark Album");
+    dashboard->SetTrackSamplerate("44.1 kHz - 16 bit");
+    dashboard->SetStatus(true);
+    dashboard->SetTrackSeek(0, 300);
+    lv_unlock();
+
+    // Idle playback - one seek tick per second
+    BenchmarkPhase("Idle playback", [](BoardHandler* board, uint32_t elapsed) {
+        board->dashboard->SetTrackSeek(elapsed / 1000, 300);
+    });
+
+    // Track change - every second switch title, artist, seek and theme
+    BenchmarkPhase("Track change", [](BoardHandler* board, uint32_t elapsed) {
+        static uint32_t last_change = UINT32_MAX;
+        uint32_t change = elapsed / 1000;
+        if (change == last_change) {
+            return;
+        }
+        last_change = change;
+
+        bool odd = change % 2;
+        const Theme* theme = odd ? get_theme("spotify") : &default_theme;
+        board->dashboard->SetTrackTitle(odd ? "Short title" : "Benchmark - A Very Long Track Title That Keeps Scrolling");
+        board->dashboard->SetTrackArtist(odd ? "Artist" : "Benchmark Artist - Benchmark Album");
+        board->dashboard->SetTrackSeek(odd ? 10 : 200, odd ? 180 : 300);
+        board->dashboard->SetPlayerIcon(theme->icon);
+        board->dashboard->SetAccentColor(theme->color);
+    });
+
+    // Popup - show and hide once per second
+    BenchmarkPhase("Popup show/hide", [](BoardHandler* board, uint32_t elapsed) {
+        if ((elapsed % 1000) < 500) {
+            board->dashboard->ShowPopup("Volume", LV_SYMBOL_VOLUME_MAX, 0);
+        } else {
+            board->dashboard->HidePopup();
+        }
+    });
+
+    // Arc drag - sweep the arc back and forth like a finger would
+    BenchmarkPhase("Arc drag", [](BoardHandler* board, uint32_t elapsed) {
+        uint32_t position = (elapsed / 10) % 600;
+        lv_arc_set_value(board->dashboard->GetArc(), position < 300 ? position : 600 - position);
+    });
+
+    lv_lock();
+    dashboard->HidePopup();
+    ResetFrameStats();
+    lv_unlock();
+}
@@ -3,13 +3,16 @@
 
 #pragma once
 #include "freertos/FreeRTOS.h"      // FreeRTOS
-#include "freertos/semphr.h"        // FreeRTOS semaphore
+#include "freertos/semphr.h"
 #include "pin_config.h"
 #include "display_config.h"
 #include "drivers/GC9A01.h"         // LCD Driver
 #include "drivers/FT3267.h"         // Touch Driver
 #include "../board/Encoder.h"
-#include "Adafruit_MAX1704X.h"
+#include "../board/Button.h"
+#include "../board/IdleManager.h"
+#include "../board/TouchFilter.h"
+#include "../board/BatteryMonitor.h"
 
 #include "lv_conf.h"                // LVGL Config
 #include <lvgl.h>                   // LVGL Library
@@ -17,26 +20,68 @@
 
 #include "../notify/NotificationManager.h"
 #include "../notify/TrackDataQueue.h"
+#include "../notify/LatencyTracer.h"
+#include "../notify/Metrics.h"
+#include "webserver/EventStream.h"
+#include "config/ConfigStore.h"
 #include "volumio/volumio_trackdata.h"
 
 #define DEEP_SLEEP_HOLD_TIME pdMS_TO_TICKS(5000)
+#define PLAYER_SELECT_CLICKS 2      // Clicks that switch to the next Volumio player
+#define WIFI_MODE_CLICKS     5      // Clicks that toggle STA / AP mode
 
 class BoardHandler {
 private:
     GC9A01_Driver lcd;
     FT3267::TP_FT3267 touch;
     Encoder encoder;
-    Adafruit_MAX17048* lipo = nullptr;
+    Button button;
+    bool button_pressed     = false;
+    bool suppress_button    = false;    // Ignore the press sequence that woke the screen
+    BatteryMonitor battery;
+
+    // Idle mode
+    IdleManager idle;
+    int32_t wake_encoder_position = 0;
+    std::string last_title  = "";
+    std::string last_status = "";
+
+    // Interrupt driven touch
+    lv_indev_t* touch_indev         = nullptr;
+    SemaphoreHandle_t touch_signal  = nullptr;  // Given by the touch ISR - wakes the display task
+    volatile bool touch_irq_pending = false;
+    volatile uint32_t touch_irq_us  = 0;        // Time of the last touch interrupt
+    TouchFilter touch_filter;                   // Gestures, wake touch - what reaches LVGL
+
+    // Touch-to-pixel latency [us] - from the interrupt to the end of the next rendered frame
+    bool touch_latency_pending      = false;
+    uint32_t touch_latency_start    = 0;
+    uint32_t touch_latency_count    = 0;
+    uint64_t touch_latency_sum      = 0;
+    uint32_t touch_latency_max      = 0;
+    TickType_t touch_stats_start    = 0;
+
+    uint8_t* draw_buf[DISPLAY_BUF_COUNT] = {};
+    Dashboard* dashboard = nullptr;
 
-    SemaphoreHandle_t semaphore;
+    // Frame time statistics [us]
+    int64_t frame_start     = 0;
+    uint32_t frame_count    = 0;
+    uint64_t frame_time_sum = 0;
+    uint32_t frame_time_max = 0;
+    TickType_t frame_stats_start = 0;
 
-    lv_color_t* draw_buf = nullptr;
-    Dashboard* dashboard = nullptr;
+    void ResetFrameStats(void);
 
     static uint32_t my_tick(void);
 
     static void DisplayFlush(lv_display_t *display, const lv_area_t *area, unsigned char *data);
 
+    /**
+     * @brief LVGL display refresh callback - measures the frame time
+     */
+    static void DisplayRefreshEvent(lv_event_t *e);
+
     /**
      * @brief FreeRTOS task entry point
      * @param param pointer to the display instance
@@ -45,18 +90,51 @@ private:
 
     /**
      * @brief LVGL touch input device read callback
+     * Reads the controller only while its INT line is low.
      */
     static void TouchEvent(lv_indev_t *indev, lv_indev_data_t *data);
 
+    /**
+     * @brief Touch INT falling edge - flags the touch and wakes the display task
+     */
+    static void TouchIsr(void* arg);
+
+    /**
+     * @brief Feed the event driven touch indev while a touch is pending or active
+     */
+    void PollTouch(void);
+
+    /**
+     * @brief Post the command of a recognized gesture with popup feedback
+     */
+    void HandleGesture(const VolumioCommand& cmd);
+
     /**
      * @brief LVGL encoder input device read callback
      */
     static void EncoderEvent(lv_indev_t *indev, lv_indev_data_t *data);
 
     /**
-     * @brief LVGL battery input device read callback
+     * @brief Low rate LVGL timer - samples the battery and updates the icon on bucket changes
+     */
+    static void BatteryTimer(lv_timer_t *timer);
+
+    /**
+     * @brief Handle queued button events - click, multi-click and hold actions
+     */
+    void ProcessButton(void);
+    void HandleButton(const ButtonEvent& event);
+
+    /**
+     * @brief Poll the wake-up sources while the screen is off (no I2C)
+     * @return true if the user touched the screen, turned the knob or pressed the button
      */
-    static void BatteryEvent(lv_indev_t *indev, lv_indev_data_t *data);
+    bool CheckWakeup(void);
+
+    /**
+     * @brief Step the idle state machine and apply backlight / render rate
+     */
+    void UpdateIdle(void);
 
     /**
      * @brief NotificationManager handler - show popup
@@ -71,6 +149,14 @@ private:
     void TestGUI(void);
     void TestPopup(void);
 
+    /**
+     * @brief Scripted render benchmark (DISPLAY_BENCHMARK)
+     * Runs idle playback, track change, popup show / hide and arc drag phases
+     * and logs frame times and RAM cost of the current buffer configuration.
+     */
+    void RunBenchmark(void);
+    void BenchmarkPhase(const char* name, void (*step)(BoardHandler*, uint32_t));
+
 public:
     BoardHandler();
     ~BoardHandler();
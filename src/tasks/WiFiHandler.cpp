@@ -1,17 +1,28 @@
 #include "WiFiHandler.h"
+#include "../platform/platform.h"
+#include "esp_timer.h"
 
-WiFiHandler::WiFiHandler() {
-    Preferences preferences;
-    preferences.begin("my-app", false);
-    #if RESET_PREFERENCES == true
-        preferences.clear();
-        DEBUG_PRINTLN("[Preferences] NVS cleared");
-    #endif
-    ssid      = preferences.getString("ssid", STA_SSID);
-    password  = preferences.getString("pass", STA_PASS);
-    volumioIP = preferences.getString("ip", VOLUMIO_IP);
-    preferences.end();
+#define WIFI_CACHE_MAGIC 0x57434331    // "WCC1"
 
+// Survives deep sleep, lost on power off - NVS is the fallback
+RTC_DATA_ATTR static WiFiCache rtc_cache;
+
+WiFiHandler::WiFiHandler() {
+    Config config = ConfigStore::getInstance().get();
+    ssid      = config.ssid.c_str();
+    password  = config.password.c_str();
+    volumioIP = config.volumio.c_str();
+
+    // Applied by the WiFi task - subscribers run in the task that changed the config
+    ConfigStore::getInstance().subscribe([this](const Config&) { configChanged = true; });
+
+    // Connection progress is event driven - the WiFi task never waits for the link
+    events = xQueueCreate(WIFI_EVENT_QUEUE, sizeof(Event));
+    eventHandler = WiFi.onEvent([this](arduino_event_id_t event, arduino_event_info_t info) {
+        this->OnEvent(event, info);
+    });
+    // Retries are the state machine's - the driver reconnecting on its own would race them
+    WiFi.setAutoReconnect(false);
     StartSTA();
 
     // Initialize DNS server (will be started only in AP mode)
@@ -49,27 +60,141 @@ WiFiHandler::WiFiHandler() {
     );
     ElegantOTA.onEnd(
         [this](bool success) {
+            ConfigStore::getInstance().flush();     // Before the restart
             NotificationManager::getInstance().postNotification( "Updating", success ? "Finished" : "Failed", 5000 );
         }
     );
 
     // Setup web server callbacks
-    IPAddress localIP = connected ? WiFi.localIP() : WiFi.softAPIP(); // Default AP IP if not connected
-    webServerCallbacks(*server, localIP);
+    webServerCallbacks(*server);
+    EventStream::getInstance().attach(*server);
+
+    // Connection phase timings
+    server->on("/wifi", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        WiFiSnapshot wifi = GetSnapshot();
+        JsonDocument doc;
+        doc["state"]      = wifi.state;
+        doc["rssi"]       = wifi.rssi;
+        doc["associate"]  = wifi.timings.associate;
+        doc["dhcp"]       = wifi.timings.dhcp;
+        doc["connect"]    = wifi.timings.connect;
+        doc["outage"]     = wifi.timings.outage;
+        doc["attempts"]   = wifi.timings.attempts;
+        doc["reconnects"] = wifi.timings.reconnects;
+        doc["reason"]     = wifi.timings.last_reason;
+        doc["fast_path"]  = wifi.timings.fast_path;
+        doc["first_state"] = wifi.timings.first_state;
+
+        String response;
+        serializeJson(doc, response);
+        request->send(200, "application/json", response);
+    });
+
+    // Prometheus text format - rendered into one static buffer, a scrape arriving while
+    // the previous response is still being sent gets a 503, a page that did not fit a 500
+    server->on("/metrics", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        static char buffer[METRICS_BUFFER];
+        static uint32_t owner = 0;      // Response reading the buffer, 0 = free
+        static uint32_t responses = 0;
+        static uint32_t truncated = 0;
+        static bool registered = false;
+
+        if (owner != 0) {
+            request->send(503);
+            return;
+        }
+        if (!registered) {
+            Metrics::getInstance().registerTask(xTaskGetCurrentTaskHandle());     // async_tcp
+            registered = true;
+        }
+
+        MetricsPage page;
+        page.heap_free     = esp_get_free_heap_size();
+        page.heap_min_free = esp_get_minimum_free_heap_size();
+        page.uptime        = esp_timer_get_time() / 1000000;
+
+        TaskHandle_t tasks[METRICS_MAX_TASKS];
+        page.task_count = Metrics::getInstance().getTasks(tasks, METRICS_MAX_TASKS);
+        for (size_t i = 0; i < page.task_count; i++) {
+            page.tasks[i] = {pcTaskGetName(tasks[i]), (uint32_t)uxTaskGetStackHighWaterMark(tasks[i])};
+        }
+
+        WiFiSnapshot wifi = GetSnapshot();
+        page.wifi_connected   = wifi.connected;
+        page.rssi             = wifi.rssi;
+        page.connect_attempts = wifi.timings.attempts;
+        page.reconnects       = wifi.timings.reconnects;
+        page.last_outage      = wifi.timings.outage;
+        page.players          = wifi.players;
+        page.players_online   = wifi.players_online;
+        page.config           = ConfigStore::getInstance().getStats();
+        page.journal          = wifi.journal;
+
+        size_t len = metrics_render_page(page, buffer, sizeof(buffer));
+        if (len >= sizeof(buffer)) {
+            // Missing series would read as reset counters - no page rather than a partial one
+            truncated++;
+            DEBUG_PRINTLN("[Metrics] Page exceeds METRICS_BUFFER (" << METRICS_BUFFER << " B), truncated " << truncated << " time(s)");
+            request->send(500, "text/plain", "metrics page exceeds METRICS_BUFFER");
+            return;
+        }
+
+        // The response reads the buffer while it is sent - free again once the last
+        // bytes are copied out, or when the client goes away before that
+        if (++responses == 0) {
+            responses = 1;      // 0 marks a free buffer
+        }
+        uint32_t id = responses;
+        owner = id;
+        request->onDisconnect([id]() {
+            if (owner == id)
+                owner = 0;
+        });
+        AsyncWebServerResponse* response = request->beginResponse("text/plain; version=0.0.4", len,
+            [id, len](uint8_t* out, size_t max, size_t index) -> size_t {
+                size_t chunk = len - index < max ? len - index : max;
+                memcpy(out, buffer + index, chunk);
+                if (index + chunk >= len && owner == id)
+                    owner = 0;
+                return chunk;
+            });
+        request->send(response);
+    });
 
     // Start web server
     server->begin();
     DEBUG_PRINTLN("[WebServer] Started on port 80");
 
-    // Initialize Volumio
-    std::string ipStr = std::string(volumioIP.c_str());
-    volumio = new Volumio(ipStr);
+    players.onState(PostState);
+    players.onLocalCommand([this](const VolumioCommand&) { ToggleMode(); });   // TOGGLE_WIFI_MODE
+    players.Setup(std::string(volumioIP.c_str()));
+}
+
+void WiFiHandler::PublishSnapshot(void) {
+    WiFiSnapshot next;
+    next.state     = StateName(state);
+    next.connected = state == State::CONNECTED;
+    next.rssi      = next.connected ? WiFi.RSSI() : 0;
+    next.timings   = timings;
+    next.journal   = players.GetJournal().getStats();
+    next.players   = players.Count();
+    next.players_online = players.Online();
+    next.selected  = players.GetSelected();
+
+    std::lock_guard<std::mutex> guard(snapshotLock);
+    snapshot = next;
+}
+
+WiFiSnapshot WiFiHandler::GetSnapshot(void) {
+    std::lock_guard<std::mutex> guard(snapshotLock);
+    return snapshot;
 }
 
 WiFiHandler::~WiFiHandler() {
-    if (volumio) {
-        delete volumio;
-        volumio = nullptr;
+    WiFi.removeEvent(eventHandler);
+    if (events) {
+        vQueueDelete(events);
+        events = nullptr;
     }
     if (server) {
         server->end();
@@ -86,170 +211,380 @@ WiFiHandler::~WiFiHandler() {
 }
 
 void WiFiHandler::RunTask(void){
-    xTaskCreatePinnedToCore(TaskEntry,      // Task entry point
-                            "WiFiTask",     // Task name
-                            4096,           // Stack depth
-                            this,           // Task parameters - pointer to this instance
-                            2,              // Task priority
-                            NULL,           // Task handle
-                            1);             // Core ID (Core 0 - Fast Core)
+    platform_task_create(TaskEntry,         // Task entry point
+                         "WiFiTask",        // Task name
+                         4096,              // Stack depth
+                         this,              // Task parameters - pointer to this instance
+                         2,                 // Task priority
+                         1);                // Core ID (Core 0 - Fast Core)
 }
 
 void WiFiHandler::TaskEntry(void* param) {
     WiFiHandler* instance = static_cast<WiFiHandler*>(param);
+    Metrics::getInstance().registerTask(xTaskGetCurrentTaskHandle());
 
     while (true) {
         instance->Update();
-        vTaskDelay(pdMS_TO_TICKS(200));
+
+        // Sleep until the next poll, a WiFi event wakes the task early
+        Event event;
+        if (instance->events != nullptr) {
+            xQueuePeek(instance->events, &event, pdMS_TO_TICKS(200));
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(200));
+        }
     }
     vTaskDelete(NULL);
 }
 
-void WiFiHandler::StartSTA(TickType_t timeout) {
-    WiFi.mode(WIFI_STA);
-    WiFi.begin(ssid, password);
-    connected = false;
+uint32_t WiFiHandler::SsidHash(void) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const char* c = ssid.c_str(); *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    }
+    return hash;
+}
 
-    TickType_t startTime = xTaskGetTickCount();
-    const TickType_t timeoutTicks = (timeout == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout);
+bool WiFiHandler::LoadCache(WiFiCache& cache) {
+    if (rtc_cache.magic != WIFI_CACHE_MAGIC) {
+        Preferences preferences;
+        preferences.begin("wifi-cache", true);
+        size_t len = preferences.getBytes("last", &rtc_cache, sizeof(rtc_cache));
+        preferences.end();
+        if (len != sizeof(rtc_cache)) {
+            rtc_cache.magic = 0;
+        }
+    }
 
-    while (WiFi.status() != WL_CONNECTED && (xTaskGetTickCount() - startTime) < timeout) {
-        vTaskDelay(500);
+    if (rtc_cache.magic != WIFI_CACHE_MAGIC || rtc_cache.ssid_hash != SsidHash() || rtc_cache.reuse >= WIFI_CACHE_MAX_REUSE) {
+        return false;
     }
+    cache = rtc_cache;
+    return true;
+}
 
-    if (WiFi.status() != WL_CONNECTED){
-        DEBUG_PRINTLN("[WiFi] Failed to connect to STA, timeout reached");
+// Same AP and lease - the entries differ at most in the reuse count
+static bool SameNetwork(const WiFiCache& a, const WiFiCache& b) {
+    return a.magic == b.magic && a.ssid_hash == b.ssid_hash && memcmp(a.bssid, b.bssid, sizeof(a.bssid)) == 0
+        && a.channel == b.channel && a.ip == b.ip && a.gateway == b.gateway && a.subnet == b.subnet && a.dns == b.dns;
+}
+
+void WiFiHandler::SaveCache(const WiFiCache& cache) {
+    // A fast connect only bumps the reuse count - RTC memory is enough for that,
+    // NVS is written when a DHCP lease brings a new AP, channel or address
+    bool changed = !SameNetwork(rtc_cache, cache);
+    rtc_cache = cache;
+    if (!changed) {
         return;
     }
 
-    connected = true;
-    DEBUG_PRINTLN("[WiFi] Connected to STA: " << ssid.c_str() << " (" << WiFi.localIP().toString().c_str() << ")");
-    std::string notifyContent = std::string(ssid.c_str()) + "\n" + WiFi.localIP().toString().c_str();
-    NotificationManager::getInstance().postNotification(
-        "Connected",
-        notifyContent,
-        5000
-    );
+    WiFiCache stored = cache;
+    stored.reuse = 0;
+    Preferences preferences;
+    preferences.begin("wifi-cache", false);
+    preferences.putBytes("last", &stored, sizeof(stored));
+    preferences.end();
+}
+
+void WiFiHandler::ClearCache(void) {
+    rtc_cache.magic = 0;
+
+    Preferences preferences;
+    preferences.begin("wifi-cache", false);
+    preferences.remove("last");
+    preferences.end();
+}
+
+void WiFiHandler::StartSTA(void) {
+    WiFi.mode(WIFI_STA);
+
+    // Fast path - associate directly to the last BSSID on its channel and reuse the IP (no scan, no DHCP)
+    attempt++;
+
+    WiFiCache cache;
+    fastPath = !fastFailed && LoadCache(cache);
+    if (fastPath) {
+        cache.reuse++;
+        SaveCache(cache);
+        WiFi.config(IPAddress(cache.ip), IPAddress(cache.gateway), IPAddress(cache.subnet), IPAddress(cache.dns));
+        WiFi.begin(ssid, password, cache.channel, cache.bssid);
+        DEBUG_PRINTLN("[WiFi] Fast connect: channel " << (int)cache.channel << ", IP " << IPAddress(cache.ip).toString());
+    }
+    else {
+        WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE);     // DHCP
+        WiFi.begin(ssid, password);
+    }
+    connected = false;
+
+    attemptStart = xTaskGetTickCount();
+    associatedAt = 0;
+    timings.attempts++;
+    SetState(State::CONNECTING);
 }
 
 void WiFiHandler::StartAP(void) {
+    attempt++;
     WiFi.mode(WIFI_AP);
     WiFi.softAP(AP_SSID, AP_PASS);
-    vTaskDelay(500); // Give AP time to start
+    connected = false;
+    SetState(State::AP_STARTING);
+}
 
-    IPAddress apIP = WiFi.softAPIP();
-    DEBUG_PRINTLN("[WiFi] AP Started: " << AP_SSID);
-    DEBUG_PRINTLN("[WiFi] AP IP Address: " << apIP.toString());
+void WiFiHandler::OnEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    Event queued = {event, 0, xTaskGetTickCount(), attempt.load()};
+
+    switch (event) {
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+            queued.reason = info.wifi_sta_disconnected.reason;
+            break;
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+        case ARDUINO_EVENT_WIFI_AP_START:
+            break;
+        default:
+            return;
+    }
 
-    // Start DNS server for captive portal
-    if (dns) {
-        dns->start(53, "*", apIP);
-        DEBUG_PRINTLN("[DNS] Started for captive portal");
+    if (events == nullptr || xQueueSend(events, &queued, 0) != pdTRUE) {
+        DEBUG_PRINTLN("[WiFi] Event queue full, event dropped: " << (int)event);
+        Metrics::getInstance().drop(MetricQueue::WIFI_EVENT);
     }
+}
 
-    // Update web server callbacks with AP IP
-    webServerCallbacks(*server, apIP);
-    connected = true;
+const char* WiFiHandler::StateName(State state) {
+    switch (state) {
+        case State::CONNECTING:  return "connecting";
+        case State::CONNECTED:   return "connected";
+        case State::WAITING:     return "waiting";
+        case State::AP_STARTING: return "ap_starting";
+        case State::AP:          return "ap";
+        default:                 return "unknown";
+    }
+}
 
-    // Post notification: "Configuration, MDNS\nAddressIP" (no timeout)
-    std::string apContent = std::string(DNS_NAME) + "\n" + apIP.toString().c_str();
-    NotificationManager::getInstance().postNotification(
-        "Configuration",
-        apContent,
-        0
-    );
+void WiFiHandler::SetState(State next) {
+    if (next == state) {
+        return;
+    }
+    DEBUG_PRINTLN("[WiFi] State: " << StateName(state) << " -> " << StateName(next));
+    state = next;
 }
 
-void WiFiHandler::Update() {
-    // Process DNS server requests (needed for captive portal in AP mode)
-    if (dns && (mode == WIFI_AP || mode == WIFI_AP_STA)) {
-        dns->processNextRequest();
+void WiFiHandler::HandleEvent(const Event& event) {
+    // Queued before the current attempt started - belongs to one that was given up
+    if (event.attempt != attempt) {
+        return;
     }
 
-    // Update connection status in STA mode
-    if (mode == WIFI_STA) {
-        bool wasConnected = connected;
-        connected = (WiFi.status() == WL_CONNECTED);
-
-        // Popup notification on network state changes
-        if (wasConnected != connected) {
-            if (connected) {
-                DEBUG_PRINTLN("[WiFi] Reconnected to STA");
-                DEBUG_PRINTLN("[WiFi] IP Address: " << WiFi.localIP().toString());
-                std::string notifyContent = std::string(ssid.c_str()) + "\n" + WiFi.localIP().toString().c_str();
-                NotificationManager::getInstance().postNotification(
-                    "Connected",
-                    notifyContent,
-                    5000
-                );
-                lastAttempt = 0;
-            } else {
-                DEBUG_PRINTLN("[WiFi] Disconnected from STA");
+    switch (event.id) {
+        case ARDUINO_EVENT_WIFI_STA_CONNECTED:
+            if (state == State::CONNECTING) {
+                associatedAt = event.time;
+                timings.associate = pdTICKS_TO_MS(event.time - attemptStart);
+            }
+            break;
+
+        case ARDUINO_EVENT_WIFI_STA_GOT_IP: {
+            if (state != State::CONNECTING) {
+                break;
+            }
+            connected = true;
+            timings.fast_path = fastPath;
+            timings.connect = pdTICKS_TO_MS(event.time - attemptStart);
+
+            // Fresh scan + DHCP result - remember it for the next boot / wake-up
+            if (!fastPath) {
+                WiFiCache cache = {};
+                cache.magic     = WIFI_CACHE_MAGIC;
+                cache.ssid_hash = SsidHash();
+                memcpy(cache.bssid, WiFi.BSSID(), sizeof(cache.bssid));
+                cache.channel   = WiFi.channel();
+                cache.ip        = (uint32_t)WiFi.localIP();
+                cache.gateway   = (uint32_t)WiFi.gatewayIP();
+                cache.subnet    = (uint32_t)WiFi.subnetMask();
+                cache.dns       = (uint32_t)WiFi.dnsIP();
+                SaveCache(cache);
+            }
+            fastFailed = false;
+            timings.dhcp = associatedAt ? pdTICKS_TO_MS(event.time - associatedAt) : 0;
+            if (linkLostAt != 0) {
+                timings.outage = pdTICKS_TO_MS(event.time - linkLostAt);
+                timings.reconnects++;
+                linkLostAt = 0;
+            }
+            SetState(State::CONNECTED);
+
+            DEBUG_PRINTLN("[WiFi] Connected to STA: " << ssid.c_str() << " (" << WiFi.localIP().toString().c_str() << ")"
+                          << " - associate " << timings.associate << " ms, dhcp " << timings.dhcp << " ms"
+                          << ", total " << timings.connect << " ms" << (fastPath ? " (fast)" : ""));
+            std::string notifyContent = std::string(ssid.c_str()) + "\n" + WiFi.localIP().toString().c_str();
+            NotificationManager::getInstance().postNotification(
+                "Connected",
+                notifyContent,
+                5000
+            );
+            break;
+        }
+
+        case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+        case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+            if (mode != WIFI_STA || state == State::WAITING) {
+                break;
+            }
+            // Leave of our own WiFi.disconnect(), reported after the next attempt started
+            if (event.id == ARDUINO_EVENT_WIFI_STA_DISCONNECTED && state == State::CONNECTING
+                && event.reason == WIFI_REASON_ASSOC_LEAVE) {
+                break;
+            }
+            if (event.id == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+                timings.last_reason = event.reason;
+            }
+
+            if (state == State::CONNECTED) {
+                DEBUG_PRINTLN("[WiFi] Disconnected from STA, reason " << (int)timings.last_reason);
                 NotificationManager::getInstance().postNotification(
                     "Disconnected",
                     "Connection lost",
                     5000
                 );
-                lastAttempt = xTaskGetTickCount();
+                linkLostAt = event.time;
+            }
+            else {
+                DEBUG_PRINTLN("[WiFi] Connection attempt failed, reason " << (int)timings.last_reason);
             }
-        }
 
-        // Auto-reconnect if disconnected (retry every 5 seconds)
-        if (!connected) {
-            TickType_t now = xTaskGetTickCount();
-            if (lastAttempt == 0 || (now - lastAttempt) >= RECONNECT_INTERVAL) {
-                DEBUG_PRINTLN("[WiFi] Attempting to reconnect...");
-                StartSTA(30000);  // 30 second timeout
-                lastAttempt = now;
+            // Still associated without an address - leave the AP. After a DISCONNECTED the
+            // driver is idle already, a disconnect() would only queue another event.
+            if (event.id == ARDUINO_EVENT_WIFI_STA_LOST_IP) {
+                WiFi.disconnect();
+            }
+            connected = false;
+            retryAt = event.time + RECONNECT_INTERVAL;
+
+            // Cached AP / lease did not work - fall back to a full scan right away
+            if (state == State::CONNECTING && fastPath) {
+                DEBUG_PRINTLN("[WiFi] Fast connect failed, falling back to scan + DHCP");
+                fastFailed = true;
+                ClearCache();
+                retryAt = event.time;
+            }
+            SetState(State::WAITING);
+            break;
+
+        case ARDUINO_EVENT_WIFI_AP_START: {
+            if (state != State::AP_STARTING) {
+                break;
             }
+            IPAddress apIP = WiFi.softAPIP();
+            DEBUG_PRINTLN("[WiFi] AP Started: " << AP_SSID);
+            DEBUG_PRINTLN("[WiFi] AP IP Address: " << apIP.toString());
+
+            // Start DNS server for captive portal
+            if (dns) {
+                dns->start(53, "*", apIP);
+                DEBUG_PRINTLN("[DNS] Started for captive portal");
+            }
+            connected = true;
+            SetState(State::AP);
+
+            // Post notification: "Configuration, MDNS\nAddressIP" (no timeout)
+            std::string apContent = std::string(DNS_NAME) + "\n" + apIP.toString().c_str();
+            NotificationManager::getInstance().postNotification(
+                "Configuration",
+                apContent,
+                0
+            );
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+void WiFiHandler::UpdateConnection(void) {
+    Event event;
+    while (events != nullptr && xQueueReceive(events, &event, 0) == pdTRUE) {
+        HandleEvent(event);
+    }
+
+    if (mode != WIFI_STA) {
+        return;
+    }
+
+    TickType_t now = xTaskGetTickCount();
+
+    // Association or DHCP hangs - drop the attempt and retry later
+    if (state == State::CONNECTING && now - attemptStart >= (fastPath ? FAST_CONNECT_TIMEOUT : CONNECT_TIMEOUT)) {
+        DEBUG_PRINTLN("[WiFi] Failed to connect to STA, timeout reached");
+        WiFi.disconnect();
+        retryAt = now + RECONNECT_INTERVAL;
+        if (fastPath) {
+            fastFailed = true;
+            ClearCache();
+            retryAt = now;
         }
+        SetState(State::WAITING);
+    }
+
+    // Auto-reconnect (retry every RECONNECT_INTERVAL)
+    if (state == State::WAITING && (int32_t)(now - retryAt) >= 0) {
+        DEBUG_PRINTLN("[WiFi] Attempting to reconnect...");
+        StartSTA();
     }
+}
 
-    // Update Volumio if connected and initialized
-    if (volumio != nullptr) {
-        volumio->Update();
+void WiFiHandler::Update() {
+    // Process DNS server requests (needed for captive portal in AP mode)
+    if (dns && (mode == WIFI_AP || mode == WIFI_AP_STA)) {
+        dns->processNextRequest();
+    }
 
-        Info trackData;
-        volumio->ParseResponse(&trackData);
-        TrackDataQueue::getInstance().postTrackData(trackData);
+    UpdateConnection();
 
-        processVolumioCommands();
+    ConfigStore::getInstance().tick(xTaskGetTickCount());
+    if (configChanged.exchange(false)) {
+        ApplyConfig();
     }
+
+    // Mirror to the browsers - frames queued since the last pass
+    EventStream::getInstance().process();
+
+    players.Update();
+    if (timings.first_state == 0 && players.GetFirstState() != 0) {
+        timings.first_state = players.GetFirstState();
+        DEBUG_PRINTLN("[WiFi] Boot to first state: " << timings.first_state << " ms"
+                      << (timings.fast_path ? " (fast connect)" : ""));
+    }
+
+    PublishSnapshot();
 }
 
-void WiFiHandler::processVolumioCommands(void) {
-    VolumioCommand cmd;
-    while (CommandQueue::getInstance().getNextCommand(cmd)) {
-        std::string commandStr;
+void WiFiHandler::PostState(const Info& state) {
+    TrackDataQueue::getInstance().postTrackData(state);
+    EventStream::getInstance().publishState(state);
+}
 
-        // Convert command type to Volumio HTTP API string
-        switch (cmd.type) {
-            case VolumioCommandType::PLAY:
-                commandStr = VOLUMIO_CMD_PLAY;
-                break;
-            case VolumioCommandType::PAUSE:
-                commandStr = VOLUMIO_CMD_PAUSE;
-                break;
-            case VolumioCommandType::TOGGLE:
-                commandStr = VOLUMIO_CMD_TOGGLE;
-                break;
-            case VolumioCommandType::NEXT:
-                commandStr = VOLUMIO_CMD_NEXT;
-                break;
-            case VolumioCommandType::PREV:
-                commandStr = VOLUMIO_CMD_PREV;
-                break;
-            case VolumioCommandType::SEEK:
-                commandStr = VOLUMIO_CMD_SEEK(cmd.value);
-                break;
-            case VolumioCommandType::RANDOM:
-                commandStr = VOLUMIO_CMD_RANDOM;
-                break;
-            case VolumioCommandType::REPEAT:
-                commandStr = VOLUMIO_CMD_REPEAT;
-                break;
+void WiFiHandler::ApplyConfig(void) {
+    Config config = ConfigStore::getInstance().get();
+
+    if (config.volumio != volumioIP.c_str()) {
+        volumioIP = config.volumio.c_str();
+        players.Setup(config.volumio);
+    }
+
+    // New network - used from the next STA attempt, right away if already in STA mode
+    if (config.ssid != ssid.c_str() || config.password != password.c_str()) {
+        ssid     = config.ssid.c_str();
+        password = config.password.c_str();
+        DEBUG_PRINTLN("[WiFi] Credentials changed: " << ssid.c_str());
+        if (mode == WIFI_STA) {
+            WiFi.disconnect();
+            fastFailed = false;
+            StartSTA();
         }
-        volumio->SendCommand(commandStr);
     }
 }
 
@@ -262,7 +597,7 @@ void WiFiHandler::ToggleMode() {
 
     // Disconnect current connection
     WiFi.disconnect();
-    vTaskDelay(100);
+    linkLostAt = 0;
 
     // Set new mode
     mode = (mode == WIFI_STA) ? WIFI_AP : WIFI_STA;
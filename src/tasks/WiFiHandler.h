@@ -15,30 +15,128 @@
 #include <Preferences.h>
 #include "wifi_config.h"
 #include "webserver/webserver.h"
-#include "volumio/volumio.h"
+#include "webserver/EventStream.h"
+#include "webserver/MetricsPage.h"
+#include "volumio/PlayerManager.h"
 #include "../notify/NotificationManager.h"
 #include "../notify/CommandQueue.h"
 #include "../notify/TrackDataQueue.h"
+#include "../notify/LatencyTracer.h"
+#include "../notify/Metrics.h"
+#include "config/ConfigStore.h"
+#include <atomic>
+#include <mutex>
 
 #define RECONNECT_INTERVAL pdMS_TO_TICKS(5000)  // 5 seconds
+#define CONNECT_TIMEOUT    pdMS_TO_TICKS(30000) // Give up an association attempt after
+#define FAST_CONNECT_TIMEOUT pdMS_TO_TICKS(3000) // Give up the cached BSSID / IP after
+#define WIFI_CACHE_MAX_REUSE 20                  // Fast connects before a DHCP refresh of the lease
+#define WIFI_EVENT_QUEUE   10
+
+/**
+ * @brief Connection phase durations [ms]
+ */
+struct WiFiTimings {
+    uint32_t associate  = 0;    // WiFi.begin() -> associated with the AP
+    uint32_t dhcp       = 0;    // associated -> got IP
+    uint32_t connect    = 0;    // WiFi.begin() -> got IP
+    uint32_t outage     = 0;    // Link lost -> got IP again (last reconnect)
+    uint32_t attempts   = 0;    // Connection attempts since boot
+    uint32_t reconnects = 0;    // Successful reconnects after a link loss
+    uint8_t last_reason = 0;    // Last disconnect reason (wifi_err_reason_t)
+    bool fast_path      = false;    // Last connect used the cached BSSID / channel / IP
+    uint32_t first_state = 0;   // Boot -> first Volumio state [ms]
+};
+
+/**
+ * @brief WiFi task state as seen by the web handlers
+ *
+ * Published by the WiFi task once per pass, copied under a mutex by the
+ * handlers (async_tcp task) - they never read the task's members directly.
+ */
+struct WiFiSnapshot {
+    const char* state       = "waiting";
+    bool connected          = false;
+    int8_t rssi             = 0;        // [dBm], 0 when not connected
+    WiFiTimings timings;
+    CommandJournal::Stats journal;
+    uint8_t players         = 0;
+    uint8_t players_online  = 0;
+    uint8_t selected        = 0;        // Index of the selected player
+};
+
+/**
+ * @brief Last good connection, kept in RTC memory (deep sleep) and NVS (power off)
+ */
+struct WiFiCache {
+    uint32_t magic;
+    uint32_t ssid_hash;     // Cache belongs to this network
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t reuse;          // Fast connects since the last DHCP lease (RTC only, 0 in NVS)
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+};
 
 class WiFiHandler {
 private:
     AsyncWebServer* server  = nullptr;
     DNSServer* dns          = nullptr;
 
-    // Config
-    String ssid             = STA_SSID;     // Use arduino's String because of preferences
+    // Config - copied from the ConfigStore
+    String ssid             = STA_SSID;
     String password         = STA_PASS;
     String volumioIP        = VOLUMIO_IP;
+    std::atomic<bool> configChanged{false};
+
+    // Pick up a changed ConfigStore (WiFi task)
+    void ApplyConfig(void);
 
     // WiFi
+    enum class State {
+        CONNECTING,     // Associating / waiting for DHCP
+        CONNECTED,      // Got IP
+        WAITING,        // Disconnected, retry at retryAt
+        AP_STARTING,    // Soft AP requested
+        AP              // Soft AP running
+    };
+
+    struct Event {
+        arduino_event_id_t id;
+        uint8_t reason;
+        TickType_t time;
+        uint32_t attempt;       // Attempt current when the event was queued
+    };
+
     WiFiMode_t mode         = WIFI_STA;
+    State state             = State::WAITING;
     bool connected          = false;
-    TickType_t lastAttempt  = 0;  // Track last reconnection attempt
+    QueueHandle_t events    = nullptr;  // Filled from the WiFi event callback
+    wifi_event_id_t eventHandler = 0;
+    std::atomic<uint32_t> attempt{0};   // Bumped by StartSTA / StartAP - older events are stale
+
+    TickType_t attemptStart = 0;        // WiFi.begin() of the current attempt
+    TickType_t associatedAt = 0;
+    TickType_t linkLostAt   = 0;        // 0 = no outage in progress
+    TickType_t retryAt      = 0;
+    WiFiTimings timings;
 
-    // Volumio
-    Volumio* volumio        = nullptr;
+    // Fast reconnect
+    bool fastPath           = false;    // Current attempt uses the cache
+    bool fastFailed         = false;    // Cache did not work - full scan + DHCP until the next success
+
+    bool LoadCache(WiFiCache& cache);
+    void SaveCache(const WiFiCache& cache);
+    void ClearCache(void);
+    uint32_t SsidHash(void);
+
+    // Volumio players, polled and commanded from the WiFi task
+    PlayerManager players;
+
+    // Post the selected player's state to the dashboard and the browsers
+    static void PostState(const Info& state);
 
     /**
      * @brief FreeRTOS task entry point
@@ -46,11 +144,27 @@ private:
      */
     static void TaskEntry(void* param);
 
-    void StartSTA(TickType_t timeout = 0);
+    // Start an association attempt - returns right away, progress comes as events
+    void StartSTA(void);
     void StartAP(void);
 
-    // Process Volumio commands queue
-    void processVolumioCommands(void);
+    /**
+     * @brief WiFi event callback (event task) - queues the event for the WiFi task
+     */
+    void OnEvent(arduino_event_id_t event, arduino_event_info_t info);
+
+    /**
+     * @brief Connection state machine - handle queued events and timeouts
+     */
+    void UpdateConnection(void);
+    void HandleEvent(const Event& event);
+    void SetState(State next);
+    static const char* StateName(State state);
+
+    // State for the web handlers
+    std::mutex snapshotLock;
+    WiFiSnapshot snapshot;
+    void PublishSnapshot(void);
 
 public:
     WiFiHandler();
@@ -59,6 +173,9 @@ public:
     void RunTask(void);
     void Update();
     void ToggleMode();
+
+    // Copy of the last published state - safe from any task
+    WiFiSnapshot GetSnapshot(void);
 };
 
 #endif // WIFI_HANDLER_H
\ No newline at end of file
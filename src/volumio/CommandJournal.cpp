@@ -0,0 +1,146 @@
+#include "CommandJournal.h"
+
+int CommandJournal::findLast(VolumioCommandType type) const {
+    for (int i = (int)count - 1; i >= 0; i--) {
+        if (entries[i].cmd.type == type)
+            return i;
+    }
+    return -1;
+}
+
+void CommandJournal::remove(size_t index) {
+    for (size_t i = index + 1; i < count; i++)
+        entries[i - 1] = entries[i];
+    count--;
+}
+
+void CommandJournal::append(const VolumioCommand& cmd, uint32_t time_ms) {
+    if (count == JOURNAL_SIZE) {
+        remove(0);
+        stats.overflows++;
+    }
+    entries[count++] = {cmd, time_ms};
+}
+
+bool CommandJournal::add(const VolumioCommand& cmd, uint32_t time_ms, const std::string& status) {
+    VolumioCommand entry = cmd;
+    int index;
+
+    switch (entry.type) {
+        case VolumioCommandType::TOGGLE:
+            // Resolve to what the user saw - replaying a toggle after the state changed would flip it back
+            if (status == "play")
+                entry.type = VolumioCommandType::PAUSE;
+            else if (status == "pause" || status == "stop")
+                entry.type = VolumioCommandType::PLAY;
+            else {
+                index = findLast(VolumioCommandType::TOGGLE);
+                if (index >= 0) {
+                    remove(index);
+                    stats.journaled++;
+                    stats.compacted += 2;
+                    return true;
+                }
+                break;
+            }
+            // fall through
+        case VolumioCommandType::PLAY:
+        case VolumioCommandType::PAUSE:
+            for (int i = (int)count - 1; i >= 0; i--) {
+                VolumioCommandType type = entries[i].cmd.type;
+                if (type == VolumioCommandType::PLAY || type == VolumioCommandType::PAUSE || type == VolumioCommandType::TOGGLE) {
+                    remove(i);
+                    stats.compacted++;
+                }
+            }
+            break;
+
+        case VolumioCommandType::RANDOM:
+        case VolumioCommandType::REPEAT:
+            index = findLast(entry.type);
+            if (index >= 0) {
+                remove(index);
+                stats.journaled++;
+                stats.compacted += 2;
+                return true;
+            }
+            break;
+
+        case VolumioCommandType::SEEK:
+            index = findLast(VolumioCommandType::SEEK);
+            if (index >= 0) {
+                remove(index);
+                stats.compacted++;
+            }
+            break;
+
+        case VolumioCommandType::NEXT:
+        case VolumioCommandType::PREV:
+            index = findLast(VolumioCommandType::SEEK);
+            if (index >= 0) {
+                remove(index);
+                stats.compacted++;
+            }
+            break;
+
+        case VolumioCommandType::VOLUME: {
+            int step = entry.value > 0 ? 1 : -1;
+            index = findLast(VolumioCommandType::VOLUME);
+            if (index >= 0) {
+                Entry& merged = entries[index];
+                int value = merged.cmd.value + step;
+                value = value > JOURNAL_MAX_VOLUME ? JOURNAL_MAX_VOLUME : (value < -JOURNAL_MAX_VOLUME ? -JOURNAL_MAX_VOLUME : value);
+                merged.cmd.value = value;
+                merged.time = time_ms;
+                stats.journaled++;
+                stats.compacted++;
+                if (value == 0)
+                    remove(index);
+                return true;
+            }
+            entry.value = step;
+            break;
+        }
+
+        default:
+            // Local commands (WiFi mode, player selection) never reach Volumio
+            return false;
+    }
+
+    append(entry, time_ms);
+    stats.journaled++;
+    return true;
+}
+
+void CommandJournal::replay(uint32_t now_ms, const std::string& status, std::vector<Entry>& out) {
+    for (size_t i = 0; i < count; i++) {
+        const Entry& entry = entries[i];
+
+        if (now_ms - entry.time > JOURNAL_MAX_AGE) {
+            stats.expired++;
+            continue;
+        }
+        if ((entry.cmd.type == VolumioCommandType::PLAY && status == "play") ||
+            (entry.cmd.type == VolumioCommandType::PAUSE && (status == "pause" || status == "stop"))) {
+            stats.deduped++;
+            continue;
+        }
+
+        // Summed volume steps go out one by one - the API only knows plus / minus
+        if (entry.cmd.type == VolumioCommandType::VOLUME) {
+            int steps = entry.cmd.value > 0 ? entry.cmd.value : -entry.cmd.value;
+            for (int step = 0; step < steps; step++) {
+                VolumioCommand cmd = entry.cmd;
+                cmd.value = entry.cmd.value > 0 ? 1 : -1;
+                if (step > 0)
+                    cmd.trace_id = 0;
+                out.push_back({cmd, entry.time});
+            }
+        }
+        else {
+            out.push_back(entry);
+        }
+        stats.replayed++;
+    }
+    count = 0;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "../notify/CommandQueue.h"
+
+#define JOURNAL_SIZE            8       // Commands kept while Volumio is unreachable
+#define JOURNAL_MAX_AGE         30000   // Older commands are not replayed [ms]
+#define JOURNAL_MAX_VOLUME      10      // Net volume steps kept
+
+/**
+ * @brief Commands issued while Volumio is unreachable, replayed once it is back
+ *
+ * Entries are compacted as they are added, the same way Volumio would apply
+ * them:
+ * - toggle is resolved against the last known status to play / pause, a later
+ *   play / pause replaces earlier ones (unresolved toggles cancel in pairs)
+ * - random / repeat toggles cancel in pairs
+ * - the last seek wins, next / prev drops a pending seek
+ * - volume steps are summed into one entry
+ *
+ * replay() hands out the commands in order with their time, skipping expired
+ * ones and play / pause that the fresh state already matches. A command that
+ * fails again is added back with that time, so it still expires JOURNAL_MAX_AGE
+ * after the user issued it.
+ */
+class CommandJournal {
+public:
+    struct Stats {
+        uint32_t journaled  = 0;    // Commands added
+        uint32_t compacted  = 0;    // Merged or cancelled on add
+        uint32_t overflows  = 0;    // Oldest dropped because the journal was full
+        uint32_t expired    = 0;    // Too old at replay
+        uint32_t deduped    = 0;    // Already matched the state at replay
+        uint32_t replayed   = 0;    // Commands handed out for sending
+    };
+
+    struct Entry {
+        VolumioCommand cmd;
+        uint32_t time;      // Last add / merge [ms]
+    };
+
+private:
+    Entry entries[JOURNAL_SIZE];
+    size_t count = 0;
+    Stats stats;
+
+    int findLast(VolumioCommandType type) const;
+    void remove(size_t index);
+    void append(const VolumioCommand& cmd, uint32_t time_ms);
+
+public:
+    /**
+     * @brief Keep a command that could not be sent
+     * @param time_ms when the command was issued (the entry's time when it comes back from replay)
+     * @param status last known playback status ("play", "pause", "stop", ...)
+     * @return false if the command type is not journaled
+     */
+    bool add(const VolumioCommand& cmd, uint32_t time_ms, const std::string& status);
+
+    /**
+     * @brief Take the commands to send now that Volumio is reachable, empties the journal
+     * @param status playback status of the fresh state
+     */
+    void replay(uint32_t now_ms, const std::string& status, std::vector<Entry>& out);
+
+    void clear(void) { count = 0; }
+    size_t size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+    const Stats& getStats(void) const { return stats; }
+};
@@ -0,0 +1,43 @@
+#include "MdnsBackend.h"
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include "mdns.h"
+#include "dev_tools.h"
+
+uint32_t MdnsBackend::queryHost(const std::string& name, uint32_t timeout_ms) {
+    IPAddress address = MDNS.queryHost(name.c_str(), timeout_ms);
+    DEBUG_PRINTLN("[mDNS] " << name.c_str() << ".local -> " << address.toString());
+    return (uint32_t)address;
+}
+
+uint32_t MdnsBackend::lookupDns(const std::string& name) {
+    IPAddress address;
+    if (WiFi.hostByName(name.c_str(), address) != 1)
+        return 0;
+    return (uint32_t)address;
+}
+
+size_t MdnsBackend::browse(const char* service, const char* proto, uint32_t timeout_ms, std::vector<Service>& found) {
+    // MDNS.queryService() always waits 3 s - query the IDF component with our own timeout
+    std::string type = std::string("_") + service;
+    std::string protocol = std::string("_") + proto;
+    mdns_result_t* results = nullptr;
+    if (mdns_query_ptr(type.c_str(), protocol.c_str(), timeout_ms, MDNS_BROWSE_MAX, &results) != ESP_OK)
+        return 0;
+
+    for (mdns_result_t* result = results; result != nullptr; result = result->next) {
+        uint32_t address = 0;
+        for (mdns_ip_addr_t* ip = result->addr; ip != nullptr; ip = ip->next) {
+            if (ip->addr.type == ESP_IPADDR_TYPE_V4) {
+                address = ip->addr.u_addr.ip4.addr;     // Network order - first octet in the lowest byte
+                break;
+            }
+        }
+        std::string hostname = result->hostname != nullptr ? result->hostname : "";
+        found.push_back({hostname, address, result->port});
+        DEBUG_PRINTLN("[mDNS] Found _" << service << "._" << proto << ": " << hostname.c_str()
+                      << " (" << IPAddress(address).toString() << ")");
+    }
+    mdns_query_results_free(results);
+    return found.size();
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "VolumioResolver.h"
+
+#define MDNS_BROWSE_MAX     8       // Volumio responders collected per browse
+
+/**
+ * @brief ResolverBackend on top of ESPmDNS and the WiFi DNS client
+ *
+ * Uses the MDNS instance started by the WiFiHandler. Calls block the WiFi
+ * task for at most one query timeout - browsing goes to the IDF mdns
+ * component directly, ESPmDNS has no timeout for it.
+ */
+class MdnsBackend : public ResolverBackend {
+public:
+    uint32_t queryHost(const std::string& name, uint32_t timeout_ms) override;
+    uint32_t lookupDns(const std::string& name) override;
+    size_t browse(const char* service, const char* proto, uint32_t timeout_ms, std::vector<Service>& found) override;
+};
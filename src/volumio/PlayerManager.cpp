@@ -0,0 +1,183 @@
+#include "PlayerManager.h"
+#include "../notify/NotificationManager.h"
+#include "../notify/LatencyTracer.h"
+#include "../platform/platform.h"
+
+PlayerManager::~PlayerManager() {
+    for (Volumio* player : players) {
+        delete player;
+    }
+}
+
+void PlayerManager::Setup(const std::string& hosts) {
+    for (Volumio* player : players) {
+        delete player;
+    }
+    players.clear();
+
+    // Pending commands and the last status belong to the old players
+    journal.clear();
+    lastStatus.clear();
+
+    // The setting is a comma or space separated host list
+    size_t start = 0;
+    while (start <= hosts.size() && players.size() < MAX_PLAYERS) {
+        size_t end = hosts.find_first_of(", ", start);
+        if (end == std::string::npos) {
+            end = hosts.size();
+        }
+        if (end > start) {
+            players.push_back(new Volumio(hosts.substr(start, end - start)));
+        }
+        start = end + 1;
+    }
+    if (players.empty()) {
+        players.push_back(new Volumio(hosts));  // Empty setting - discovery
+    }
+    scheduler.setCount(players.size());
+    for (size_t i = 0; i < players.size(); i++) {
+        players[i]->SetSelected(i == scheduler.getSelected());
+    }
+    DEBUG_PRINTLN("[Volumio] " << players.size() << " player(s) configured");
+}
+
+void PlayerManager::Select(int index) {
+    if (players.size() < 2) {
+        return;
+    }
+    if (index < 0 || index >= (int)players.size()) {
+        index = (scheduler.getSelected() + 1) % players.size();
+    }
+
+    // Pending commands were meant for the previous player
+    journal.clear();
+    lastStatus.clear();
+
+    Selected()->SetSelected(false);
+    scheduler.select(index, platform_millis());
+    Volumio* player = Selected();
+    player->SetSelected(true);
+
+    // Switch right away from the cached state, the fresh one follows with the next poll
+    PostState(player);
+
+    DEBUG_PRINTLN("[Volumio] Selected player " << index << ": " << player->GetHost());
+    std::string content = player->GetHost() + "\n" + (player->isConnected() ? player->GetAddress() : std::string("Offline"));
+    NotificationManager::getInstance().postNotification("Player", content, 2000);
+}
+
+void PlayerManager::Update(void) {
+    if (players.empty()) {
+        return;
+    }
+
+    // One state fetch per pass - the selected player first, the others when due.
+    // Only the fetched player resolves its host, so one pass blocks for one lookup at most.
+    uint32_t now = platform_millis();
+    int index = scheduler.next(now);
+    if (index >= 0) {
+        Volumio* player = players[index];
+        player->Update();
+        scheduler.done(index, now, player->isConnected());
+
+        if (player == Selected()) {
+            if (firstState == 0 && player->isConnected()) {
+                firstState = platform_millis();
+            }
+            PostState(player);
+
+            // State is back - send what was issued while Volumio was unreachable
+            if (player->isConnected() && !journal.empty()) {
+                ReplayJournal();
+            }
+        }
+    }
+
+    ProcessCommands();
+}
+
+uint32_t PlayerManager::Wait(void) const {
+    return players.empty() ? POLL_SELECTED : scheduler.wait(platform_millis());
+}
+
+size_t PlayerManager::Online(void) const {
+    size_t online = 0;
+    for (Volumio* player : players) {
+        online += player->isConnected() ? 1 : 0;
+    }
+    return online;
+}
+
+void PlayerManager::PostState(Volumio* player) {
+    Info trackData;
+    player->ParseResponse(&trackData);
+    if (player->isConnected() && trackData.status != "null") {
+        lastStatus = trackData.status;
+    }
+    if (stateHandler) {
+        stateHandler(trackData);
+    }
+}
+
+static std::string CommandString(const VolumioCommand& cmd) {
+    // Convert command type to Volumio HTTP API string
+    switch (cmd.type) {
+        case VolumioCommandType::PLAY:      return VOLUMIO_CMD_PLAY;
+        case VolumioCommandType::PAUSE:     return VOLUMIO_CMD_PAUSE;
+        case VolumioCommandType::TOGGLE:    return VOLUMIO_CMD_TOGGLE;
+        case VolumioCommandType::NEXT:      return VOLUMIO_CMD_NEXT;
+        case VolumioCommandType::PREV:      return VOLUMIO_CMD_PREV;
+        case VolumioCommandType::SEEK:      return VOLUMIO_CMD_SEEK(cmd.value);
+        case VolumioCommandType::RANDOM:    return VOLUMIO_CMD_RANDOM;
+        case VolumioCommandType::REPEAT:    return VOLUMIO_CMD_REPEAT;
+        case VolumioCommandType::VOLUME:    return (cmd.value > 0) ? VOLUMIO_CMD_VOLUME_UP : VOLUMIO_CMD_VOLUME_DOWN;
+        default:                            return "";
+    }
+}
+
+void PlayerManager::Send(const VolumioCommand& cmd, uint32_t time_ms) {
+    // Behind a pending replay, or Volumio unreachable - keep it for the reconnect
+    if (!journal.empty() || !Selected()->SendCommand(CommandString(cmd), cmd.trace_id)) {
+        if (journal.add(cmd, time_ms, lastStatus)) {
+            DEBUG_PRINTLN("[Volumio] Offline, command journaled (" << journal.size() << " pending)");
+        }
+    }
+}
+
+void PlayerManager::ProcessCommands(void) {
+    VolumioCommand cmd;
+    while (CommandQueue::getInstance().getNextCommand(cmd)) {
+        LatencyTracer::getInstance().mark(cmd.trace_id, TraceStage::DEQUEUED);
+
+        switch (cmd.type) {
+            case VolumioCommandType::SELECT_PLAYER:
+                Select(cmd.value);
+                break;
+            case VolumioCommandType::POLL_PERIOD:
+                scheduler.setSelectedPeriod(cmd.value > 0 ? (uint32_t)cmd.value : 0, platform_millis());
+                break;
+            case VolumioCommandType::TOGGLE_WIFI_MODE:
+                if (localCommandHandler) {
+                    localCommandHandler(cmd);
+                }
+                break;
+            default:
+                Send(cmd, platform_millis());
+                break;
+        }
+    }
+}
+
+void PlayerManager::ReplayJournal(void) {
+    std::vector<CommandJournal::Entry> commands;
+    journal.replay(platform_millis(), lastStatus, commands);
+
+    const CommandJournal::Stats& stats = journal.getStats();
+    DEBUG_PRINTLN("[Volumio] Replaying " << commands.size() << " command(s), expired " << stats.expired
+                  << ", deduplicated " << stats.deduped << " (total)");
+
+    // Lost again - back into the journal, in order, aging from when it was issued
+    for (const CommandJournal::Entry& entry : commands) {
+        Send(entry.cmd, entry.time);
+    }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+#include "volumio.h"
+#include "PollScheduler.h"
+#include "CommandJournal.h"
+#include "../notify/CommandQueue.h"
+
+/**
+ * @brief The Volumio players and the loop that polls and commands them
+ *
+ * Owns up to MAX_PLAYERS Volumio instances, the PollScheduler deciding which
+ * one is fetched and the CommandJournal keeping commands for the selected one
+ * while it is unreachable. Update() does one pass: poll the due player, replay
+ * the journal once the selected player is back, send the queued commands.
+ *
+ * Runs on the platform layer only - the WiFi task drives it on the device,
+ * the volumio_sim on the host. Where the state goes and the commands it does
+ * not handle itself (WiFi mode) are hooks of the owner.
+ */
+class PlayerManager {
+public:
+    // Fresh state of the selected player
+    typedef std::function<void(const Info& state)> StateHandler;
+    // Queued command that is not meant for Volumio
+    typedef std::function<void(const VolumioCommand& cmd)> LocalCommandHandler;
+
+private:
+    std::vector<Volumio*> players;
+    PollScheduler scheduler;
+
+    // Commands issued while the selected player was unreachable
+    CommandJournal journal;
+    std::string lastStatus;     // Playback status of the last fetched state
+    uint32_t firstState = 0;    // First state of the selected player [ms], 0 = none yet
+
+    StateHandler stateHandler;
+    LocalCommandHandler localCommandHandler;
+
+    // Pass the player's last fetched state to the state handler
+    void PostState(Volumio* player);
+    void ProcessCommands(void);
+    void ReplayJournal(void);
+    // Send to the selected player, journal it if that fails or a replay is pending
+    void Send(const VolumioCommand& cmd, uint32_t time_ms);
+
+public:
+    PlayerManager() = default;
+    ~PlayerManager();
+
+    PlayerManager(const PlayerManager&) = delete;
+    void operator=(const PlayerManager&) = delete;
+
+    void onState(StateHandler handler) { stateHandler = handler; }
+    void onLocalCommand(LocalCommandHandler handler) { localCommandHandler = handler; }
+
+    /**
+     * @brief (Re)create the players from the host list setting, drops pending commands
+     * @param hosts comma or space separated hosts, empty for discovery
+     */
+    void Setup(const std::string& hosts);
+
+    /**
+     * @brief Make another player the selected one, drops pending commands
+     * @param index player index, out of range for the next one
+     */
+    void Select(int index);
+
+    /**
+     * @brief One pass - poll the due player, replay, send the queued commands
+     */
+    void Update(void);
+
+    // Time until the next poll is due [ms], 0 if one is due already
+    uint32_t Wait(void) const;
+
+    Volumio* Selected(void) { return players.empty() ? nullptr : players[scheduler.getSelected()]; }
+    uint8_t GetSelected(void) const { return scheduler.getSelected(); }
+    size_t Count(void) const { return players.size(); }
+    size_t Online(void) const;
+    uint32_t GetFirstState(void) const { return firstState; }
+    const CommandJournal& GetJournal(void) const { return journal; }
+};
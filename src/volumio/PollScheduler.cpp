@@ -0,0 +1,90 @@
+#include "PollScheduler.h"
+
+void PollScheduler::setCount(uint8_t count) {
+    this->count = count > MAX_PLAYERS ? MAX_PLAYERS : count;
+    if (selected >= this->count)
+        selected = 0;
+    for (Slot& slot : slots)
+        slot = Slot();
+}
+
+void PollScheduler::select(uint8_t index, uint32_t now_ms) {
+    if (index >= count)
+        return;
+    selected = index;
+    slots[index].due = now_ms;
+}
+
+void PollScheduler::setSelectedPeriod(uint32_t period_ms, uint32_t now_ms) {
+    selectedPeriod = period_ms > 0 ? period_ms : POLL_SELECTED;
+
+    // Back from idle - don't wait out the slow period
+    Slot& slot = slots[selected];
+    if (count > 0 && slot.failures == 0 && (int32_t)(slot.due - (now_ms + selectedPeriod)) > 0)
+        slot.due = now_ms + selectedPeriod;
+}
+
+uint32_t PollScheduler::period(uint8_t index) const {
+    const Slot& slot = slots[index];
+    uint32_t base = index == selected ? selectedPeriod : POLL_BACKGROUND;
+    if (slot.failures == 0)
+        return base;
+
+    if (index == selected)
+        return base > POLL_BACKGROUND ? base : POLL_BACKGROUND;
+
+    uint32_t backoff = POLL_BACKGROUND << (slot.failures > 4 ? 4 : slot.failures);
+    return backoff > POLL_OFFLINE_MAX ? POLL_OFFLINE_MAX : backoff;
+}
+
+uint32_t PollScheduler::jitter(uint32_t period) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed % (period * POLL_JITTER / 100 + 1);
+}
+
+int PollScheduler::next(uint32_t now_ms) const {
+    if (count == 0)
+        return -1;
+    if ((int32_t)(now_ms - slots[selected].due) >= 0)
+        return selected;
+
+    int best = -1;
+    for (uint8_t i = 0; i < count; i++) {
+        if ((int32_t)(now_ms - slots[i].due) < 0)
+            continue;
+        if (best < 0 || (int32_t)(slots[i].due - slots[best].due) < 0)
+            best = i;
+    }
+    return best;
+}
+
+void PollScheduler::done(uint8_t index, uint32_t now_ms, bool success) {
+    if (index >= count)
+        return;
+    Slot& slot = slots[index];
+    if (success)
+        slot.failures = 0;
+    else if (slot.failures < 255)
+        slot.failures++;
+    uint32_t delay = period(index);
+    if (index != selected)
+        delay += jitter(delay);
+    slot.due = now_ms + delay;
+}
+
+uint32_t PollScheduler::wait(uint32_t now_ms) const {
+    if (count == 0)
+        return POLL_BACKGROUND;
+
+    uint32_t shortest = POLL_OFFLINE_MAX;
+    for (uint8_t i = 0; i < count; i++) {
+        int32_t remaining = (int32_t)(slots[i].due - now_ms);
+        if (remaining <= 0)
+            return 0;
+        if ((uint32_t)remaining < shortest)
+            shortest = remaining;
+    }
+    return shortest;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <stdint.h>
+
+#define MAX_PLAYERS         4       // Volumio instances tracked at once
+#define POLL_SELECTED       200     // State poll of the selected player [ms]
+#define POLL_BACKGROUND     5000    // State poll of the other players [ms]
+#define POLL_OFFLINE_MAX    30000   // Backoff limit for unreachable players [ms]
+#define POLL_JITTER         10      // Spread added to background polls [% of the period]
+
+/**
+ * @brief Decides which player's state is fetched next
+ *
+ * One fixed slot per player. The selected player is polled at POLL_SELECTED
+ * (or the slower period set while the display is idle), the others at
+ * POLL_BACKGROUND, so their cached state stays fresh enough to
+ * switch to without waiting. Unreachable players back off exponentially up to
+ * POLL_OFFLINE_MAX - except the selected one, which is retried at
+ * POLL_BACKGROUND at worst.
+ *
+ * Background polls are delayed by up to POLL_JITTER percent of their period,
+ * so players that were configured or went offline together don't keep
+ * hitting the network in the same pass. The jitter comes from a fixed-seed
+ * xorshift, every run with the same inputs gives the same schedule.
+ */
+class PollScheduler {
+private:
+    struct Slot {
+        uint32_t due        = 0;    // [ms]
+        uint8_t failures    = 0;    // Consecutive failed polls
+    };
+
+    Slot slots[MAX_PLAYERS];
+    uint8_t count       = 0;
+    uint8_t selected    = 0;
+    uint32_t selectedPeriod = POLL_SELECTED;
+    uint32_t seed       = 0x9E3779B9;   // xorshift32 state of the jitter
+
+    uint32_t period(uint8_t index) const;
+    uint32_t jitter(uint32_t period);
+
+public:
+    void setCount(uint8_t count);
+    uint8_t getCount(void) const { return count; }
+
+    /**
+     * @brief Make the player the foreground one - it is polled right away
+     */
+    void select(uint8_t index, uint32_t now_ms);
+    uint8_t getSelected(void) const { return selected; }
+
+    /**
+     * @brief Poll period of the selected player (slower while the display is idle)
+     * @param period_ms 0 for POLL_SELECTED - a shorter period takes effect right away
+     */
+    void setSelectedPeriod(uint32_t period_ms, uint32_t now_ms);
+    uint32_t getSelectedPeriod(void) const { return selectedPeriod; }
+
+    /**
+     * @brief Player to poll now - the selected player first, then the most overdue
+     * @return index, -1 if nothing is due
+     */
+    int next(uint32_t now_ms) const;
+
+    /**
+     * @brief Report the poll result and schedule the next poll of the player
+     */
+    void done(uint8_t index, uint32_t now_ms, bool success);
+
+    /**
+     * @brief Time until the next poll is due [ms], 0 if one is due already
+     */
+    uint32_t wait(uint32_t now_ms) const;
+
+    // Next poll of the player [ms]
+    uint32_t getDue(uint8_t index) const { return index < count ? slots[index].due : 0; }
+};
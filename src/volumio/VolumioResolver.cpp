@@ -0,0 +1,145 @@
+#include "VolumioResolver.h"
+
+bool VolumioResolver::parseAddress(const std::string& text, uint32_t& address) {
+    uint32_t result = 0;
+    uint32_t octet  = 0;
+    int digits      = 0;
+    int dots        = 0;
+
+    for (char c : text) {
+        if (c >= '0' && c <= '9') {
+            octet = octet * 10 + (c - '0');
+            if (++digits > 3 || octet > 255)
+                return false;
+        }
+        else if (c == '.' && digits > 0 && dots < 3) {
+            result |= octet << (8 * dots);
+            octet  = 0;
+            digits = 0;
+            dots++;
+        }
+        else {
+            return false;
+        }
+    }
+    if (dots != 3 || digits == 0)
+        return false;
+
+    address = result | (octet << 24);
+    return true;
+}
+
+std::string VolumioResolver::formatAddress(uint32_t address) {
+    return std::to_string(address & 0xFF) + "." + std::to_string((address >> 8) & 0xFF) + "." +
+           std::to_string((address >> 16) & 0xFF) + "." + std::to_string(address >> 24);
+}
+
+VolumioResolver::Entry* VolumioResolver::find(const std::string& host) {
+    for (Entry& entry : entries) {
+        if (entry.expires != 0 && entry.host == host)
+            return &entry;
+    }
+    return nullptr;
+}
+
+// Entry for the host - reuses a free or the least recently used slot
+VolumioResolver::Entry& VolumioResolver::slot(const std::string& host, uint32_t now_ms) {
+    Entry* victim = &entries[0];
+    for (Entry& entry : entries) {
+        if (entry.expires == 0) {
+            victim = &entry;
+            break;
+        }
+        if ((int32_t)(entry.last_used - victim->last_used) < 0)
+            victim = &entry;
+    }
+    *victim = Entry();
+    victim->host = host;
+    victim->last_used = now_ms;
+    return *victim;
+}
+
+uint32_t VolumioResolver::lookup(const std::string& host, uint32_t& ttl) {
+    static const std::string suffix = ".local";
+    lookups++;
+    ttl = RESOLVER_TTL;
+
+    if (isDiscovery(host)) {
+        std::vector<ResolverBackend::Service> found;
+        backend.browse(VOLUMIO_SERVICE, VOLUMIO_SERVICE_PROTO, RESOLVER_TIMEOUT, found);
+        // First responder with an address
+        for (const ResolverBackend::Service& service : found) {
+            if (service.address != 0)
+                return service.address;
+        }
+        return 0;
+    }
+
+    if (host.size() > suffix.size() && host.compare(host.size() - suffix.size(), suffix.size(), suffix) == 0)
+        return backend.queryHost(host.substr(0, host.size() - suffix.size()), RESOLVER_TIMEOUT);
+
+    ttl = RESOLVER_DNS_TTL;
+    return backend.lookupDns(host);
+}
+
+uint32_t VolumioResolver::retryDelay(uint8_t misses) {
+    uint32_t delay = RESOLVER_RETRY << (misses > 5 ? 4 : misses - 1);
+    return delay > RESOLVER_RETRY_MAX ? RESOLVER_RETRY_MAX : delay;
+}
+
+bool VolumioResolver::resolve(const std::string& host, uint32_t now_ms, std::string& address) {
+    uint32_t numeric;
+    if (parseAddress(host, numeric)) {
+        address = host;
+        return true;
+    }
+
+    Entry* entry = find(host);
+    if (entry != nullptr && (int32_t)(now_ms - entry->expires) < 0) {
+        entry->last_used = now_ms;
+        if (entry->address == 0)
+            return false;
+        hits++;
+        address = formatAddress(entry->address);
+        return true;
+    }
+
+    uint32_t ttl;
+    uint32_t found = lookup(host, ttl);
+
+    if (found == 0) {
+        failures++;
+        // Expired but still known - keep using it until a request fails
+        if (entry != nullptr && entry->address != 0) {
+            if (entry->misses < 255)
+                entry->misses++;
+            entry->expires = (now_ms + retryDelay(entry->misses)) | 1;
+            entry->last_used = now_ms;
+            address = formatAddress(entry->address);
+            return true;
+        }
+    }
+
+    if (entry == nullptr)
+        entry = &slot(host, now_ms);
+
+    if (found != 0)
+        entry->misses = 0;
+    else if (entry->misses < 255)
+        entry->misses++;
+
+    entry->address   = found;
+    entry->expires   = (now_ms + (found != 0 ? ttl : retryDelay(entry->misses))) | 1;  // 0 marks a free slot
+    entry->last_used = now_ms;
+
+    if (found == 0)
+        return false;
+    address = formatAddress(found);
+    return true;
+}
+
+void VolumioResolver::invalidate(const std::string& host) {
+    Entry* entry = find(host);
+    if (entry != nullptr)
+        *entry = Entry();
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#define VOLUMIO_SERVICE         "volumio"   // DNS-SD service advertised by Volumio (_Volumio._tcp)
+#define VOLUMIO_SERVICE_PROTO   "tcp"
+#define VOLUMIO_DISCOVER        "auto"      // Host setting that selects mDNS discovery
+#define RESOLVER_CACHE_SIZE     4
+#define RESOLVER_TTL            120000      // mDNS host record TTL (RFC 6762) [ms]
+#define RESOLVER_DNS_TTL        300000      // Unicast DNS answers [ms]
+#define RESOLVER_RETRY          5000        // Wait after a failed lookup, doubled per miss [ms]
+#define RESOLVER_RETRY_MAX      60000       // Backoff limit for a host that keeps missing [ms]
+#define RESOLVER_TIMEOUT        500         // Single mDNS query or service browse [ms]
+
+/**
+ * @brief Name lookups used by the resolver
+ *
+ * Addresses are IPv4 with the first octet in the lowest byte (same layout as
+ * IPAddress's uint32_t cast), 0 = not found. The device implementation wraps
+ * ESPmDNS and the WiFi DNS client, a host stand-in can answer from a table.
+ */
+class ResolverBackend {
+public:
+    struct Service {
+        std::string hostname;
+        uint32_t address;
+        uint16_t port;
+    };
+
+    virtual ~ResolverBackend() = default;
+
+    virtual uint32_t queryHost(const std::string& name, uint32_t timeout_ms) = 0;  // mDNS A record, name without ".local"
+    virtual uint32_t lookupDns(const std::string& name) = 0;                       // Unicast DNS
+    virtual size_t browse(const char* service, const char* proto, uint32_t timeout_ms, std::vector<Service>& found) = 0;
+};
+
+/**
+ * @brief Resolves the configured Volumio host with a small TTL cache
+ *
+ * - dotted IPv4 addresses pass through without any lookup
+ * - "*.local" names are queried over mDNS, other names over unicast DNS
+ * - "auto" (or an empty host) browses for Volumio DNS-SD services
+ *
+ * Answers are cached until their TTL runs out. An expired entry is refreshed,
+ * but kept when the refresh fails - the old address usually still works.
+ * Callers drop the entry with invalidate() when a request to it fails, so the
+ * next resolve() looks the name up again. A lookup blocks the caller for up
+ * to RESOLVER_TIMEOUT when the host is missing, so failed lookups are not
+ * repeated for RESOLVER_RETRY, doubled with every further miss of the same
+ * host up to RESOLVER_RETRY_MAX.
+ */
+class VolumioResolver {
+private:
+    struct Entry {
+        std::string host;
+        uint32_t address    = 0;    // 0 = negative entry
+        uint32_t expires    = 0;    // [ms]
+        uint32_t last_used  = 0;
+        uint8_t misses      = 0;    // Failed lookups in a row
+    };
+
+    ResolverBackend& backend;
+    Entry entries[RESOLVER_CACHE_SIZE];
+
+    // Statistics
+    uint32_t hits       = 0;
+    uint32_t lookups    = 0;
+    uint32_t failures   = 0;
+
+    Entry* find(const std::string& host);
+    Entry& slot(const std::string& host, uint32_t now_ms);
+    uint32_t lookup(const std::string& host, uint32_t& ttl);
+    static uint32_t retryDelay(uint8_t misses);
+
+public:
+    explicit VolumioResolver(ResolverBackend& backend) : backend(backend) { }
+
+    /**
+     * @brief Address of the host
+     * @param host configured host (IP, name or "auto")
+     * @param now_ms current time
+     * @param address dotted IPv4 address on success
+     * @return false if the host can't be resolved (yet)
+     */
+    bool resolve(const std::string& host, uint32_t now_ms, std::string& address);
+
+    /**
+     * @brief Forget the cached address - call when a request to it failed
+     */
+    void invalidate(const std::string& host);
+
+    static bool parseAddress(const std::string& text, uint32_t& address);
+    static std::string formatAddress(uint32_t address);
+    static bool isDiscovery(const std::string& host) { return host.empty() || host == VOLUMIO_DISCOVER; }
+
+    uint32_t getHits(void) const { return hits; }
+    uint32_t getLookups(void) const { return lookups; }
+    uint32_t getFailures(void) const { return failures; }
+};
@@ -1,16 +1,43 @@
-#include "Volumio.h"
+#include "volumio.h"
 #include "../notify/NotificationManager.h"
+#include "../notify/LatencyTracer.h"
+#include "../notify/Metrics.h"
+#include "../platform/platform.h"
+#include "VolumioResolver.h"
 
-Volumio::Volumio(std::string ip) : ip(ip) { }
+// Shared by all players
+static VolumioResolver resolver(platform_resolver_backend());
+
+Volumio::Volumio(std::string host) : host(host) { }
 Volumio::~Volumio(){ }
 
+bool Volumio::Resolve(void) {
+    std::string resolved;
+    if (!resolver.resolve(host, platform_millis(), resolved)) {
+        VOLUMIO_DEBUG_PRINTLN("[VOLUMIO] Can't resolve " << host);
+        return false;
+    }
+    if (resolved != address) {
+        DEBUG_PRINTLN("[VOLUMIO] " << host << " -> " << resolved);
+        address = resolved;
+    }
+    return true;
+}
+
+void Volumio::RequestFailed(int httpCode) {
+    // HTTP errors come from a reachable server, connection errors are negative
+    if (httpCode < 0) {
+        resolver.invalidate(host);
+    }
+}
+
 void Volumio::Update(void){
-    if (WiFi.status() != WL_CONNECTED) {
+    if (!platform_net_connected()) {
         connected = false;
         return;
     }
 
-    if (wasConnected != connected) {
+    if (selected && wasConnected != connected) {
         if (connected) {
             NotificationManager::getInstance().postNotification(
                 "Volumio",
@@ -27,22 +54,37 @@ void Volumio::Update(void){
     }
     wasConnected = connected;
 
-    HTTPClient http;
-    std::string volumioURL = "http://" + ip + ":3000/api/v1/getState";
-    http.begin(volumioURL.c_str());
-    int httpCode = http.GET();
+    if (!Resolve()) {
+        Response = std::string("");
+        stateTrace = 0;
+        connected = false;
+        return;
+    }
+
+    std::string volumioURL = "http://" + address + ":3000/api/v1/getState";
+    std::string body;
+    uint32_t start = platform_millis();
+    int httpCode = platform_http_get(volumioURL, &body);
 
-    if (httpCode > 0 && httpCode == HTTP_CODE_OK) {
-        Response = std::string(http.getString().c_str());
+    if (httpCode == PLATFORM_HTTP_OK) {
+        Metrics::getInstance().observe(MetricHistogram::VOLUMIO_STATE, platform_millis() - start);
+        Response = body;
         VOLUMIO_DEBUG_PRINTLN("[VOLUMIO] Update success");
         connected = true;
+
+        // First state after the command ack
+        stateTrace = ackedTrace;
+        ackedTrace = 0;
+        LatencyTracer::getInstance().mark(stateTrace, TraceStage::FETCHED);
     }
     else{
         Response = std::string("");
+        stateTrace = 0;
         VOLUMIO_DEBUG_PRINTLN("[VOLUMIO] Update failed");
+        Metrics::getInstance().error(MetricHistogram::VOLUMIO_STATE);
         connected = false;
+        RequestFailed(httpCode);
     }
-    http.end();
 }
 
 void Volumio::ParseResponse(Info *trackdata){
@@ -61,22 +103,32 @@ void Volumio::ParseResponse(Info *trackdata){
     trackdata->random        = doc["random"].as<bool>();
     trackdata->repeat        = doc["repeat"].as<bool>();
     trackdata->repeatSingle  = doc["repeatSingle"].as<bool>();
+    trackdata->trace_id      = stateTrace;
+    stateTrace = 0;
 }
 
-void Volumio::SendCommand(std::string command){
-    if (WiFi.status() != WL_CONNECTED || isConnected() == false)
-        return;
+bool Volumio::SendCommand(std::string command, uint32_t trace_id){
+    if (!platform_net_connected() || isConnected() == false || !Resolve())
+        return false;
 
-    HTTPClient http;
-    std::string volumioURL = "http://" + ip + "/api/v1/commands/?cmd=" + command;
-    http.begin(volumioURL.c_str());
-    int httpCode = http.GET();
+    std::string volumioURL = "http://" + address + "/api/v1/commands/?cmd=" + command;
+    uint32_t start = platform_millis();
+    int httpCode = platform_http_get(volumioURL, nullptr);
 
-    if (httpCode > 0 && httpCode == HTTP_CODE_OK) {
+    if (httpCode == PLATFORM_HTTP_OK) {
+        Metrics::getInstance().observe(MetricHistogram::VOLUMIO_COMMAND, platform_millis() - start);
         VOLUMIO_DEBUG_PRINTLN("[VOLUMIO] Command sent successfully: " << command);
+        if (trace_id != 0) {
+            LatencyTracer::getInstance().mark(trace_id, TraceStage::ACKED);
+            ackedTrace = trace_id;
+        }
     }
     else {
         VOLUMIO_DEBUG_PRINTLN("[VOLUMIO] Command failed: " << command);
+        Metrics::getInstance().error(MetricHistogram::VOLUMIO_COMMAND);
+        RequestFailed(httpCode);
     }
-    http.end();
+
+    // An HTTP error still reached Volumio - only transport errors are worth a retry
+    return httpCode > 0;
 }
\ No newline at end of file
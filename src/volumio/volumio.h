@@ -3,8 +3,6 @@
 
 #pragma once
 
-#include <WiFi.h>
-#include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include <string>
 #include "volumio_trackdata.h"
@@ -21,23 +19,36 @@
 
 class Volumio {
 private:
-    std::string ip;
+    std::string host;           // Configured IP, host name or "auto"
+    std::string address;        // Resolved IP of the last request
     std::string Response = std::string("");
     bool connected = false;
     bool wasConnected = false;
+    bool selected = true;       // Connection changes are notified for the selected player only
+    uint32_t ackedTrace = 0;    // Newest acknowledged command waiting for a state fetch
+    uint32_t stateTrace = 0;    // Trace id of the command included in Response
 
     inline bool CheckResponse(void) { return Response != std::string(""); }
 
+    // Resolve the host through the shared cache - false if it is unknown
+    bool Resolve(void);
+    // Transport error (no HTTP status) - the address may be stale
+    void RequestFailed(int httpCode);
+
 public:
-    Volumio(std::string ip);
+    Volumio(std::string host);
     ~Volumio();
 
     inline bool isConnected(void) { return connected; }
-    void SetIP(std::string ip) { this->ip = ip; }
+    void SetIP(std::string host) { this->host = host; address.clear(); }
+    const std::string& GetAddress(void) { return address; }
+    const std::string& GetHost(void) { return host; }
+    void SetSelected(bool selected) { this->selected = selected; }
 
     void Update(void);
     void ParseResponse(Info* trackdata);
-    void SendCommand(std::string command);
+    // false if Volumio could not be reached (the command may be retried later)
+    bool SendCommand(std::string command, uint32_t trace_id = 0);
 };
 
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define VOLUMIO_TRACKDATA_H
 
 #include <string>
+#include <stdint.h>
 
 struct Info {
     std::string status      = "";
@@ -16,6 +17,7 @@ struct Info {
     bool random             = false;
     bool repeat             = false;
     bool repeatSingle       = false;
+    uint32_t trace_id       = 0;    // Newest traced command included in this state
 };
 
 #endif // VOLUMIO_TRACKDATA_H
\ No newline at end of file
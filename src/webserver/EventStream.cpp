@@ -0,0 +1,129 @@
+#include "EventStream.h"
+#include <ArduinoJson.h>
+#include "dev_tools.h"
+#include "../notify/Metrics.h"
+
+EventStream* EventStream::instance = nullptr;
+
+EventStream::EventStream() : source("/events") {
+    // Queue stores pointers to Frame (heap-allocated)
+    queue = xQueueCreate(QUEUE_SIZE, sizeof(Frame*));
+    if (queue == nullptr) {
+        DEBUG_PRINTLN("[Events] Failed to create frame queue");
+    }
+}
+
+EventStream::~EventStream() {
+    if (queue != nullptr) {
+        Frame* frame = nullptr;
+        while (xQueueReceive(queue, &frame, 0) == pdTRUE) {
+            delete frame;
+        }
+        vQueueDelete(queue);
+        queue = nullptr;
+    }
+}
+
+EventStream& EventStream::getInstance() {
+    if (instance == nullptr) {
+        instance = new EventStream();
+    }
+    return *instance;
+}
+
+const char* EventStream::topicName(StreamTopic topic) {
+    switch (topic) {
+        case StreamTopic::STATE:    return "state";
+        case StreamTopic::POPUP:    return "popup";
+        case StreamTopic::BATTERY:  return "battery";
+        default:                    return "unknown";
+    }
+}
+
+void EventStream::attach(AsyncWebServer& server) {
+    // Replay the current view to a new client
+    source.onConnect([this](AsyncEventSourceClient* client) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (size_t topic = 0; topic < (size_t)StreamTopic::COUNT; topic++) {
+            if (!last[topic].empty()) {
+                client->send(last[topic].c_str(), topicName((StreamTopic)topic), next_id, EVENT_STREAM_RETRY);
+            }
+        }
+    });
+    server.addHandler(&source);
+}
+
+bool EventStream::publish(StreamTopic topic, std::string json) {
+    if (queue == nullptr) {
+        return false;
+    }
+
+    Frame* frame = new Frame{topic, std::move(json)};
+    if (xQueueSend(queue, &frame, 0) != pdTRUE) {
+        Metrics::getInstance().drop(MetricQueue::EVENT_STREAM);
+        delete frame;
+        return false;
+    }
+    return true;
+}
+
+bool EventStream::publishState(const Info& info) {
+    JsonDocument doc;
+    doc["status"]       = info.status;
+    doc["title"]        = info.title;
+    doc["artist"]       = info.artist;
+    doc["album"]        = info.album;
+    doc["trackType"]    = info.trackType;
+    doc["seek"]         = info.seek;
+    doc["duration"]     = info.duration;
+    doc["samplerate"]   = info.samplerate;
+    doc["bitdepth"]     = info.bitdepth;
+    doc["random"]       = info.random;
+    doc["repeat"]       = info.repeat;
+    doc["repeatSingle"] = info.repeatSingle;
+
+    std::string json;
+    serializeJson(doc, json);
+    return publish(StreamTopic::STATE, std::move(json));
+}
+
+bool EventStream::publishPopup(const char* title, const char* content) {
+    JsonDocument doc;
+    doc["title"]   = title;
+    doc["content"] = content;
+
+    std::string json;
+    serializeJson(doc, json);
+    return publish(StreamTopic::POPUP, std::move(json));
+}
+
+bool EventStream::publishBattery(int percent) {
+    return publish(StreamTopic::BATTERY, "{\"level\":" + std::to_string(percent) + "}");
+}
+
+void EventStream::process(void) {
+    if (queue == nullptr) {
+        return;
+    }
+
+    Frame* frame = nullptr;
+    while (xQueueReceive(queue, &frame, 0) == pdTRUE) {
+        size_t topic = (size_t)frame->topic;
+        uint32_t id;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (topic >= (size_t)StreamTopic::COUNT || last[topic] == frame->json) {
+                delete frame;
+                continue;
+            }
+            last[topic] = frame->json;
+            id = next_id++;
+        }
+
+        // Serialized once, fanned out to every client
+        if (source.count() > 0) {
+            source.send(frame->json.c_str(), topicName(frame->topic), id);
+        }
+        delete frame;
+    }
+}
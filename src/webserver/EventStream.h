@@ -0,0 +1,82 @@
+#ifndef EVENT_STREAM_H
+#define EVENT_STREAM_H
+
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include <mutex>
+#include <string>
+#include "volumio/volumio_trackdata.h"
+
+#define EVENT_STREAM_RETRY  3000    // Browser reconnect delay [ms]
+
+/**
+ * @brief Kinds of frames mirrored to the browsers
+ */
+enum class StreamTopic : uint8_t {
+    STATE,      // Track and playback state
+    POPUP,      // Popup / notification shown on the knob
+    BATTERY,    // Battery level bucket
+    COUNT
+};
+
+/**
+ * @brief Server-Sent Events mirror of what the knob shows (/events)
+ *
+ * Any task publishes frames through a bounded queue, the WiFi task sends
+ * them with process(). A frame is serialized once and sent to all clients,
+ * and only if it differs from the last frame of its topic. New clients get
+ * the last frame of every topic on connect. The per-client backlog is capped
+ * by SSE_MAX_QUEUED_MESSAGES - slow clients lose frames instead of memory.
+ */
+class EventStream {
+private:
+    struct Frame {
+        StreamTopic topic;
+        std::string json;
+    };
+
+    AsyncEventSource source;
+    QueueHandle_t queue;
+    static constexpr size_t QUEUE_SIZE = 8;
+
+    std::mutex lock;    // last is read by the async_tcp task on connect
+    std::string last[(size_t)StreamTopic::COUNT];
+    uint32_t next_id = 1;
+
+    static EventStream* instance;
+    EventStream();
+
+    bool publish(StreamTopic topic, std::string json);
+
+public:
+    ~EventStream();
+
+    EventStream(const EventStream&) = delete;
+    void operator=(const EventStream&) = delete;
+
+    static EventStream& getInstance();
+
+    /**
+     * @brief Register /events on the web server
+     */
+    void attach(AsyncWebServer& server);
+
+    // Non-blocking, callable from any task - false if the queue is full
+    bool publishState(const Info& info);
+    bool publishPopup(const char* title, const char* content);
+    bool publishBattery(int percent);
+
+    /**
+     * @brief Send queued frames to the clients (WiFi task)
+     */
+    void process(void);
+
+    size_t getClientCount(void) { return source.count(); }
+
+    static const char* topicName(StreamTopic topic);
+};
+
+#endif // EVENT_STREAM_H
@@ -0,0 +1,55 @@
+#include "MetricsPage.h"
+
+size_t metrics_render_page(const MetricsPage& page, char* buffer, size_t size) {
+    size_t len = 0;
+    len = metrics_printf(buffer, size, len,
+        "# TYPE heap_free_bytes gauge\nheap_free_bytes %u\n"
+        "# TYPE heap_min_free_bytes gauge\nheap_min_free_bytes %u\n"
+        "# TYPE uptime_seconds counter\nuptime_seconds %u\n",
+        (unsigned)page.heap_free, (unsigned)page.heap_min_free, (unsigned)page.uptime);
+
+    len = metrics_printf(buffer, size, len, "# HELP task_stack_free_min_bytes Stack high-water mark\n"
+                                            "# TYPE task_stack_free_min_bytes gauge\n");
+    for (size_t i = 0; i < page.task_count && i < METRICS_MAX_TASKS; i++) {
+        len = metrics_printf(buffer, size, len, "task_stack_free_min_bytes{task=\"%s\"} %u\n",
+                             page.tasks[i].name, (unsigned)page.tasks[i].stack_free);
+    }
+
+    len = metrics_printf(buffer, size, len,
+        "# TYPE wifi_connected gauge\nwifi_connected %d\n"
+        "# TYPE wifi_rssi_dbm gauge\nwifi_rssi_dbm %d\n"
+        "# TYPE wifi_connect_attempts_total counter\nwifi_connect_attempts_total %u\n"
+        "# TYPE wifi_reconnects_total counter\nwifi_reconnects_total %u\n"
+        "# TYPE wifi_last_outage_ms gauge\nwifi_last_outage_ms %u\n"
+        "# TYPE volumio_players gauge\nvolumio_players %u\n"
+        "# TYPE volumio_players_online gauge\nvolumio_players_online %u\n",
+        page.wifi_connected ? 1 : 0, page.rssi,
+        (unsigned)page.connect_attempts, (unsigned)page.reconnects, (unsigned)page.last_outage,
+        (unsigned)page.players, (unsigned)page.players_online);
+
+    const ConfigStats& config = page.config;
+    len = metrics_printf(buffer, size, len,
+        "# TYPE config_reads_total counter\nconfig_reads_total %u\n"
+        "# TYPE config_updates_total counter\nconfig_updates_total %u\n"
+        "# TYPE config_nvs_writes_total counter\nconfig_nvs_writes_total %u\n"
+        "# TYPE config_nvs_writes_skipped_total counter\nconfig_nvs_writes_skipped_total %u\n"
+        "# TYPE config_nvs_load_us gauge\nconfig_nvs_load_us %u\n"
+        "# TYPE config_nvs_write_us gauge\nconfig_nvs_write_us %u\n",
+        (unsigned)config.reads, (unsigned)config.updates, (unsigned)config.writes,
+        (unsigned)config.skipped, (unsigned)config.load_us, (unsigned)config.last_write_us);
+
+    const CommandJournal::Stats& journaled = page.journal;
+    len = metrics_printf(buffer, size, len,
+        "# HELP command_journal_total Commands kept while Volumio was unreachable\n"
+        "# TYPE command_journal_total counter\n"
+        "command_journal_total{result=\"journaled\"} %u\n"
+        "command_journal_total{result=\"compacted\"} %u\n"
+        "command_journal_total{result=\"overflow\"} %u\n"
+        "command_journal_total{result=\"expired\"} %u\n"
+        "command_journal_total{result=\"deduplicated\"} %u\n"
+        "command_journal_total{result=\"replayed\"} %u\n",
+        (unsigned)journaled.journaled, (unsigned)journaled.compacted, (unsigned)journaled.overflows,
+        (unsigned)journaled.expired, (unsigned)journaled.deduped, (unsigned)journaled.replayed);
+
+    return Metrics::getInstance().render(buffer, size, len);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../notify/Metrics.h"
+#include "../config/ConfigStore.h"
+#include "../volumio/CommandJournal.h"
+
+/**
+ * @brief Values of the /metrics page that live outside the Metrics registry
+ *
+ * The WiFi task's web handler collects them from the system, the WiFi
+ * snapshot and the ConfigStore. The Metrics histograms and drop counters
+ * are appended by metrics_render_page() itself.
+ */
+struct MetricsPage {
+    struct Task {
+        const char* name;
+        uint32_t stack_free;    // High-water mark [B]
+    };
+
+    uint32_t heap_free          = 0;
+    uint32_t heap_min_free      = 0;
+    uint32_t uptime             = 0;    // [s]
+
+    Task tasks[METRICS_MAX_TASKS] = {};
+    size_t task_count           = 0;
+
+    bool wifi_connected         = false;
+    int rssi                    = 0;    // [dBm]
+    uint32_t connect_attempts   = 0;
+    uint32_t reconnects         = 0;
+    uint32_t last_outage        = 0;    // [ms]
+    uint32_t players            = 0;
+    uint32_t players_online     = 0;
+
+    ConfigStats config;
+    CommandJournal::Stats journal;
+};
+
+/**
+ * @brief Render the whole page in the Prometheus text format
+ * @return length, size if the page did not fit (see metrics_printf)
+ */
+size_t metrics_render_page(const MetricsPage& page, char* buffer, size_t size);
@@ -0,0 +1,51 @@
+// Fetch SSID and IP from ESP when page loads
+async function loadNetworkConfig() {
+    try {
+        const response = await fetch('/get');
+        if (!response.ok) throw new Error('Failed to fetch network data');
+        const data = await response.json();
+        document.getElementById('ssid').value = data.ssid || '';
+        document.getElementById('ip').value = data.ip || '';
+    } catch (error) {
+        console.error('Error loading network config:', error);
+    }
+}
+
+// Handle form submission without reloading
+document.getElementById('network-form').addEventListener('submit', async function(event) {
+    event.preventDefault(); // Prevent default form submission
+
+    const formData = {
+        ssid: document.getElementById('ssid').value,
+        pass: document.getElementById('pass').value,
+        ip: document.getElementById('ip').value
+    };
+
+    try {
+        const response = await fetch('/post', {
+            method: 'POST',
+            headers: { 'Content-Type': 'application/json' },
+            body: JSON.stringify(formData)
+        });
+
+        const statusText = document.getElementById('status');
+        statusText.style.display = 'block';
+
+        if (response.ok) {
+            statusText.innerText = '✅ Settings saved successfully!';
+            statusText.style.color = 'green';
+        } else {
+            statusText.innerText = '❌ Failed to save settings!';
+            statusText.style.color = 'red';
+        }
+    } catch (error) {
+        console.error('Error saving settings:', error);
+        const statusText = document.getElementById('status');
+        statusText.innerText = '❌ Error connecting to server!';
+        statusText.style.color = 'red';
+        statusText.style.display = 'block';
+    }
+});
+
+// Load network config on page load
+window.onload = loadNetworkConfig;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ESPAsyncWebServer.h>
+
+#define ASSET_CACHE_IMMUTABLE   "public, max-age=31536000, immutable"   // Content hashed URLs
+#define ASSET_CACHE_PAGE        "no-cache"                              // Revalidate with the ETag
+
+/**
+ * @brief Gzipped web asset embedded in flash by script/embed_html.py
+ */
+struct EmbeddedAsset {
+    const char* url;
+    const char* type;
+    const uint8_t* data;
+    unsigned int len;
+    const char* etag;       // Quoted content hash
+    bool immutable;         // URL contains the hash - cache forever
+};
+
+#include "build/assets.h"
+
+/**
+ * @brief Serve one embedded asset - 304 when the client already has this version
+ */
+inline void sendAsset(AsyncWebServerRequest *request, const EmbeddedAsset& asset) {
+    const char* cache = asset.immutable ? ASSET_CACHE_IMMUTABLE : ASSET_CACHE_PAGE;
+
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset.etag) {
+        AsyncWebServerResponse *response = request->beginResponse(304);
+        response->addHeader("ETag", asset.etag);
+        response->addHeader("Cache-Control", cache);
+        request->send(response);
+        return;
+    }
+
+    // Streamed straight from flash, no copy in RAM
+    AsyncWebServerResponse *response = request->beginResponse_P(200, asset.type, asset.data, asset.len);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", cache);
+    request->send(response);
+}
+
+/**
+ * @brief Register a route for every embedded asset
+ */
+inline void assetCallbacks(AsyncWebServer& server) {
+    for (size_t i = 0; i < embedded_assets_count; i++) {
+        const EmbeddedAsset& asset = embedded_assets[i];
+        server.on(asset.url, HTTP_GET, [&asset](AsyncWebServerRequest *request) {
+            sendAsset(request, asset);
+        });
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POST_BODY_LIMIT 1024    // Largest accepted request body [B]
+
+/**
+ * @brief Request body assembled from the chunks of an AsyncWebServer body callback
+ *
+ * Allocated once with the announced total size, so chunks are copied without
+ * reallocations. Plain C struct allocated with malloc - it lives in the
+ * request's _tempObject, which the server releases with free().
+ */
+struct BodyBuffer {
+    uint16_t status;    // 200 while valid, else the HTTP error to answer with
+    size_t size;        // Bytes received so far
+    size_t total;       // Announced body size
+    char data[];        // total + 1 bytes, zero terminated when complete
+};
+
+/**
+ * @brief Allocate a buffer for a body of `total` bytes
+ * @return buffer with status 413 if the body exceeds `limit`, nullptr if out of memory
+ */
+inline BodyBuffer* body_create(size_t total, size_t limit = POST_BODY_LIMIT) {
+    bool fits = total <= limit;
+    BodyBuffer* body = (BodyBuffer*)malloc(sizeof(BodyBuffer) + (fits ? total + 1 : 0));
+    if (body == nullptr)
+        return nullptr;
+
+    body->status = fits ? 200 : 413;
+    body->size   = 0;
+    body->total  = fits ? total : 0;
+    if (fits)
+        body->data[0] = '\0';
+    return body;
+}
+
+/**
+ * @brief Copy a chunk at its offset - chunks must arrive in order and within total
+ * @return false once the body is invalid (status tells why)
+ */
+inline bool body_append(BodyBuffer* body, const uint8_t* data, size_t len, size_t index) {
+    if (body == nullptr || body->status != 200)
+        return false;
+
+    if (index != body->size || len > body->total - body->size) {
+        body->status = 400;
+        return false;
+    }
+
+    if (len > 0)
+        memcpy(body->data + index, data, len);      // data may be null for an empty chunk
+    body->size += len;
+    body->data[body->size] = '\0';
+    return true;
+}
+
+inline bool body_complete(const BodyBuffer* body) {
+    return body != nullptr && body->status == 200 && body->size == body->total;
+}
@@ -2,49 +2,92 @@
 
 #include <ESPAsyncWebServer.h>
 #include <IPAddress.h>
-#include "build/html.h"
+#include <WiFi.h>
+#include "assets.h"
 #include <ArduinoJson.h>
-#include <Preferences.h>
 #include "wifi_config.h"
+#include "config/ConfigStore.h"
+#include "../notify/LatencyTracer.h"
+#include "../notify/CommandQueue.h"
+#include "body_buffer.h"
 
-inline void webServerCallbacks(AsyncWebServer& server, const IPAddress& localIP){
-    const String IP_URL = "http://" + localIP.toString();
+/**
+ * @brief URL of the device in the current WiFi mode - resolved per request
+ */
+inline String localURL(void) {
+    IPAddress ip = (WiFi.getMode() & WIFI_MODE_AP) ? WiFi.softAPIP() : WiFi.localIP();
+    return "http://" + ip.toString();
+}
 
-    server.onNotFound(                  [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });               // Not found redirect
+inline void webServerCallbacks(AsyncWebServer& server){
+
+    server.onNotFound(                  [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });               // Not found redirect
 
     // Required for captive portal - this is stolen from the other project
     server.on("/connecttest.txt",       [](AsyncWebServerRequest *request)          { request->redirect("http://logout.net"); });  // Windows 11 captive portal workaround
     server.on("/wpad.dat",              [](AsyncWebServerRequest *request)          { request->send(404); });                      // Honestly don't understand what this is but a 404 stops win 10 keep calling this repeatedly and panicking the esp32 :)
 
-    server.on("/generate_204",          [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });               // Android captive portal redirect
-    server.on("/redirect",              [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });               // Microsoft redirect
-    server.on("/hotspot-detect.html",   [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });               // Apple call home
-    server.on("/canonical.html",        [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });               // Firefox captive portal call home
+    server.on("/generate_204",          [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });               // Android captive portal redirect
+    server.on("/redirect",              [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });               // Microsoft redirect
+    server.on("/hotspot-detect.html",   [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });               // Apple call home
+    server.on("/canonical.html",        [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });               // Firefox captive portal call home
     server.on("/success.txt",           [](AsyncWebServerRequest *request)          { request->send(200); });                      // Firefox captive portal call home
-    server.on("/ncsi.txt",              [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });               // Windows call home
+    server.on("/ncsi.txt",              [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });               // Windows call home
 
     server.on("/chrome-variations/seed",[](AsyncWebServerRequest *request)          { request->send(200); });                      // Chrome captive portal call home
     server.on("/service/update2/json",  [](AsyncWebServerRequest *request)          { request->send(200); });                      // Firefox?
     server.on("/chat",                  [](AsyncWebServerRequest *request)          { request->send(404); });                      // No stop asking WhatsApp, there is no internet connection
-    server.on("/startpage",             [IP_URL](AsyncWebServerRequest *request)    { request->redirect(IP_URL); });
+    server.on("/startpage",             [](AsyncWebServerRequest *request)          { request->redirect(localURL()); });
+
+    // Page, stylesheet and script - cache validated (ETag / 304)
+    assetCallbacks(server);
 
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
-        AsyncWebServerResponse *response = request->beginResponse(200, "text/html", (const uint8_t*)html, html_len);
-        response->addHeader("Content-Encoding", "gzip");
-        request->send(response);
+    // Input latency percentiles per stage [ms]
+    server.on("/trace", HTTP_GET, [](AsyncWebServerRequest *request) {
+        request->send(200, "application/json", LatencyTracer::getInstance().toJson().c_str());
+    });
+
+    // Control from the browser - /command?cmd=<name>[&value=<n>], the result comes back over /events
+    server.on("/command", HTTP_POST, [](AsyncWebServerRequest *request) {
+        static const struct { const char* name; VolumioCommandType type; } commands[] = {
+            {"play",   VolumioCommandType::PLAY},
+            {"pause",  VolumioCommandType::PAUSE},
+            {"toggle", VolumioCommandType::TOGGLE},
+            {"next",   VolumioCommandType::NEXT},
+            {"prev",   VolumioCommandType::PREV},
+            {"seek",   VolumioCommandType::SEEK},
+            {"random", VolumioCommandType::RANDOM},
+            {"repeat", VolumioCommandType::REPEAT},
+            {"volume", VolumioCommandType::VOLUME},
+            {"player", VolumioCommandType::SELECT_PLAYER},
+        };
+
+        const AsyncWebParameter* cmdParam = request->getParam("cmd");
+        const AsyncWebParameter* valueParam = request->getParam("value");
+        if (cmdParam == nullptr) {
+            request->send(400, "application/json", "{\"status\":\"error\", \"message\":\"Missing cmd\"}");
+            return;
+        }
+
+        for (const auto& command : commands) {
+            if (cmdParam->value() == command.name) {
+                int value = command.type == VolumioCommandType::SELECT_PLAYER ? -1 : 0;    // Default: next player
+                VolumioCommand cmd = {command.type, valueParam ? (int)valueParam->value().toInt() : value};
+                bool queued = CommandQueue::getInstance().postCommand(cmd);
+                request->send(queued ? 202 : 503, "application/json", queued ? "{\"status\":\"queued\"}" : "{\"status\":\"busy\"}");
+                return;
+            }
+        }
+        request->send(400, "application/json", "{\"status\":\"error\", \"message\":\"Unknown cmd\"}");
     });
 
     // On page boot Fill the form with the current network configuration
     server.on("/get", HTTP_GET, [](AsyncWebServerRequest *request) {
-        Preferences preferences;
-        preferences.begin("my-app", false);
-        String ssid      = preferences.getString("ssid", STA_SSID);
-        String volumioIP = preferences.getString("ip", VOLUMIO_IP);
-        preferences.end();
+        Config config = ConfigStore::getInstance().get();
 
         JsonDocument doc;
-        doc["ssid"] = ssid;
-        doc["ip"]   = volumioIP;
+        doc["ssid"] = config.ssid;
+        doc["ip"]   = config.volumio;
 
         String response;
         serializeJson(doc, response);
@@ -52,33 +95,39 @@ inline void webServerCallbacks(AsyncWebServer& server, const IPAddress& localIP)
 	});
 
     // get posted data and update the network configuration
-    server.on("/post", HTTP_POST, [](AsyncWebServerRequest *request) {}, NULL, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+    // The body is assembled from its chunks first, the request handler runs once it is complete
+    server.on("/post", HTTP_POST, [](AsyncWebServerRequest *request) {
+        BodyBuffer* body = static_cast<BodyBuffer*>(request->_tempObject);
 
-        String body = "";
-        for (size_t i = 0; i < len; i++) {
-            body += (char)data[i];  // Convert incoming bytes to String
+        if (body != nullptr && body->status == 413) {
+            request->send(413, "application/json", "{\"status\":\"error\", \"message\":\"Request too large\"}");
+            return;
+        }
+        if (!body_complete(body)) {
+            request->send(400, "application/json", "{\"status\":\"error\", \"message\":\"Incomplete body\"}");
+            return;
         }
 
         JsonDocument doc;
-        DeserializationError error = deserializeJson(doc, body.c_str());
+        DeserializationError error = deserializeJson(doc, body->data, body->size);
 
         if (error) {
             request->send(400, "application/json", "{\"status\":\"error\", \"message\":\"Invalid JSON\"}");
             return;
         }
 
-        String ssid      = doc["ssid"];
-        String password  = doc["pass"];
-        String volumioIP = doc["ip"];
-
-        /* Save new config */
-        Preferences preferences;
-        preferences.begin("my-app", false);
-        preferences.putString("ssid", ssid);
-        preferences.putString("pass", password);
-        preferences.putString("ip", volumioIP);
-        preferences.end();
+        /* Save new config - missing fields keep their value, NVS is written in the background */
+        Config config = ConfigStore::getInstance().get();
+        config.ssid     = doc["ssid"] | config.ssid;
+        config.password = doc["pass"] | config.password;
+        config.volumio  = doc["ip"]   | config.volumio;
+        ConfigStore::getInstance().update(config);
 
         request->send(200, "application/json", "{\"status\":\"success\"}");
+    }, NULL, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+        if (index == 0 && request->_tempObject == nullptr) {
+            request->_tempObject = body_create(total);
+        }
+        body_append(static_cast<BodyBuffer*>(request->_tempObject), data, len, index);
     });
 }
\ No newline at end of file